@@ -0,0 +1,17 @@
+/**
+ * Allocation Trace
+ * Counts malloc / calloc / realloc calls made by the calling task between
+ * allocTraceBegin() and allocTraceEnd() - Arduino String, new and LVGL
+ * (LV_STDLIB_CLIB) all end up there.
+ *
+ * Debug only: needs -DUI_ALLOC_TRACE plus the --wrap linker flags (see the
+ * commented line in platformio.ini). Without them the calls do nothing and
+ * allocTraceEnabled() returns false.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+void allocTraceBegin();
+uint32_t allocTraceEnd();   // Allocations since allocTraceBegin()
+bool allocTraceEnabled();
@@ -0,0 +1,28 @@
+/**
+ * Persistent Album Art Cache
+ * Decoded + scaled ART_SIZE frames stored on a LittleFS partition, compressed with
+ * a QOI-style RGB565 codec. Survives reboots so cache-warm tracks skip the WAN fetch.
+ *
+ * Only the art task touches the cache (no locking). Stats may be read from anywhere.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+// Mount the partition and load the LRU index (art task, once at startup)
+bool initArtFlashCache();
+
+// Load a cached frame into dst (ART_SIZE x ART_SIZE RGB565). Returns false on miss.
+bool artFlashLoad(uint32_t key, uint16_t* dst, uint32_t* dominant_color);
+
+// Compress and persist a frame, evicting least-recently-used entries over quota
+void artFlashStore(uint32_t key, const uint16_t* src, uint32_t dominant_color);
+
+// Drop a cached frame (art changed on the server)
+void artFlashInvalidate(uint32_t key);
+
+// Record the cost of a cache-miss network fetch + decode, for latency comparison
+void artFlashNoteNetworkLoad(uint32_t ms);
+
+// Hit rate, load latency and usage (called from periodic heap logging)
+void artFlashLogStats();
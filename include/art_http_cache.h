@@ -0,0 +1,37 @@
+/**
+ * Album Art HTTP Metadata Cache
+ * ETag/Last-Modified validators for conditional revalidation, a TTL'd negative cache
+ * for URLs that can never succeed, and a bytes-downloaded-per-hour counter.
+ *
+ * Keys are the canonical art keys from artThumbKey(). Art task only, except stats.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+// Why a URL is negatively cached (each reason has its own TTL)
+enum ArtNegReason {
+    ART_NEG_NONE = 0,
+    ART_NEG_NOT_FOUND,     // HTTP 404 / 410
+    ART_NEG_OVERSIZE,      // Content-Length or body above MAX_ART_SIZE
+    ART_NEG_UNSUPPORTED,   // Not JPEG/PNG, PNG for non-logo, or repeatedly undecodable
+};
+
+// Negative cache: returns the cached reason, or ART_NEG_NONE if absent/expired
+ArtNegReason artNegLookup(uint32_t key);
+void artNegStore(uint32_t key, ArtNegReason reason);
+const char* artNegReasonName(ArtNegReason reason);
+
+// Validators from the last 200 response (recorded even if the server sent none);
+// get returns false when there are none to send
+void artHttpStoreValidators(uint32_t key, const String& etag, const String& last_modified);
+bool artHttpGetValidators(uint32_t key, String& etag, String& last_modified);
+
+// True when a locally cached frame should be revalidated: validated too long ago, or
+// never since boot (then the GET is unconditional)
+bool artHttpNeedsRevalidate(uint32_t key);
+void artHttpMarkValidated(uint32_t key);
+
+// Downloaded body bytes (rolling 60-minute window)
+void artHttpNoteBytes(uint32_t bytes);
+void artHttpLogStats();
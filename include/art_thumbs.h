@@ -0,0 +1,43 @@
+/**
+ * Album Art Thumbnail Cache
+ * Mip chain (120 / 60 px) emitted from every full-size art decode, shared by the
+ * "Next" panel and queue rows so they never trigger extra downloads or decodes
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Mip levels below the full ART_SIZE frame (which lives in art_buffer)
+enum ArtThumbLevel {
+    ART_THUMB_120 = 0,
+    ART_THUMB_60  = 1,
+};
+
+// Allocate the PSRAM slot pool (call once before the art task starts)
+void initArtThumbs();
+
+// Canonical cache key for an art URL (scheme and local Sonos host stripped, so
+// "/getaa?..." from the queue matches "http://<ip>:1400/getaa?..." from track info)
+uint32_t artThumbKey(const char* url);
+
+// Build the mip chain from a decoded ART_SIZE x ART_SIZE RGB565 frame (art task only)
+void artThumbStore(uint32_t key, const uint16_t* art);
+
+// Forget a key (its art changed on the server). Pinned slots stay on screen until released.
+void artThumbInvalidate(uint32_t key);
+
+// Look up a thumbnail and pin it so it can't be evicted while displayed.
+// Returns nullptr on miss. Every non-null result must be released exactly once.
+const lv_image_dsc_t* artThumbAcquire(uint32_t key, ArtThumbLevel level);
+void artThumbRelease(const lv_image_dsc_t* dsc);
+
+// Create an image showing the thumbnail, or nullptr on miss.
+// The pin is released automatically when the image object is deleted.
+lv_obj_t* artThumbCreateImage(lv_obj_t* parent, uint32_t key, ArtThumbLevel level);
+
+// Incremented on every store - lets the UI retry misses only when something new arrived
+uint32_t artThumbGeneration();
+
+// Hit/miss/eviction counters (called from periodic heap logging)
+void artThumbLogStats();
@@ -0,0 +1,22 @@
+/**
+ * Album Art URL Rewrite Rules
+ * Table-driven CDN rewrites applied in a single pass: Sonos Radio imgix unwrapping,
+ * per-CDN size negotiation (smallest variant >= ART_DISPLAY_SIZE), HTTPS -> HTTP
+ * downgrades for public CDNs, and getaa u= escaping.
+ *
+ * Plain C (no Arduino/LVGL) so the rules can be compiled and exercised on a host.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Flags reported by artRewriteURL()
+#define ART_URL_UNWRAPPED   0x01    // Sonos Radio imgix wrapper removed (inner mark= URL used)
+#define ART_URL_RESIZED     0x02    // CDN size parameter lowered
+#define ART_URL_DOWNGRADED  0x04    // https:// replaced by http://
+#define ART_URL_ESCAPED     0x08    // Raw '?' escaped inside the getaa u= parameter
+
+// Rewrite `in` into `out` (NUL-terminated). Returns the output length, or 0 if the
+// result does not fit in out_len (out is then left empty). flags may be null.
+size_t artRewriteURL(const char* in, char* out, size_t out_len, uint8_t* flags);
@@ -62,24 +62,109 @@
 #define PANEL_WIDTH             480     // Physical panel width (portrait)
 #define PANEL_HEIGHT            800     // Physical panel height (portrait)
 
+// =============================================================================
+// PROFILER
+// =============================================================================
+#define PROFILER_RING_SIZE      256     // Frame samples kept by the profiler (~8s at 30 fps)
+
+// =============================================================================
+// RENDER GOVERNOR
+// =============================================================================
+// Refresh rate follows UI activity
+#define GOVERNOR_IDLE_AFTER_MS  3000    // No touch, track change or animation for this long -> idle
+#define GOVERNOR_REFR_IDLE_MS   50      // Idle refresh period (20 fps)
+#define GOVERNOR_REFR_DIMMED_MS 200     // Dimmed refresh period (5 fps)
+#define GOVERNOR_INDEV_DIMMED_MS 50     // Touch poll period while dimmed (bounds wake latency)
+#define GOVERNOR_MAX_SLEEP_MS   100     // Longest loop() sleep (watchdog, WiFi and heap checks)
+
+// =============================================================================
+// QUEUE LIST
+// =============================================================================
+// Virtual list: a fixed row pool is rebound to queue indices while scrolling
+#define QUEUE_ROW_HEIGHT        60      // Row pitch (pixels)
+#define QUEUE_ROW_POOL          10      // Row widgets kept alive (6-7 visible + overscan)
+#define QUEUE_ROW_OVERSCAN      1       // Rows bound above the first visible one
+
+// =============================================================================
+// BROWSE LIST
+// =============================================================================
+// Virtual, like the queue list
+#define BROWSE_ROW_HEIGHT       70      // Row pitch (60 px row + 10 px gap)
+#define BROWSE_ROW_POOL         9       // Row widgets kept alive (6 visible + overscan)
+#define BROWSE_ROW_OVERSCAN     1       // Rows bound above the first visible one
+
+// =============================================================================
+// LIBRARY SEARCH
+// =============================================================================
+// Music library A:ARTIST / A:ALBUM / A:TRACKS through the browse cache
+#define SEARCH_DEBOUNCE_MS      350     // Typing pause before a query goes out
+#define SEARCH_MIN_CHARS        2       // Shorter terms don't query
+#define SEARCH_TERM_LEN         32      // Max search term length
+#define SEARCH_RECENT           6       // Recent result sets kept for local refinement (PSRAM)
+#define SEARCH_TITLE_LEN        64      // Title bytes kept per recent result
+#define SEARCH_RESULT_ROWS      30      // Result row widgets (created once)
+
+// =============================================================================
+// QUICK-LAUNCH GRID
+// =============================================================================
+// Sources screen: first page of Favorites + Playlists
+#define LAUNCH_MAX_TILES        12      // Tiles (kept under the 20 thumbnail slots)
+#define LAUNCH_TILE_WIDTH       136     // 120 px thumbnail + padding, 4 per row
+#define LAUNCH_TILE_HEIGHT      170
+#define LAUNCH_REFRESH_MS       60000   // Background re-request of both pages (UpdateID check)
+
 // =============================================================================
 // ALBUM ART
 // =============================================================================
 #define ART_DISPLAY_SIZE        420     // Album art display size (pixels)
 #define ART_MAX_DOWNLOAD_SIZE   (280 * 1024)  // Max JPEG download buffer (280KB)
-#define ART_TASK_STACK_SIZE     7000    // Album art task stack (increased for HW JPEG + HTTPS/TLS)
+#define ART_TASK_STACK_SIZE     8192    // Album art task stack (HW JPEG + HTTPS/TLS + LittleFS art cache)
 #define ART_TASK_PRIORITY       0       // Album art task priority
 #define ART_DOWNLOAD_TIMEOUT_MS 8000    // Download timeout
 #define ART_CHECK_INTERVAL_MS   100     // How often to check for new art requests
 
+// Thumbnail mip chain (generated from each 420px decode, shared by Next panel + queue rows)
+#define ART_THUMB_SIZE_L        120     // Large thumbnail edge (pixels)
+#define ART_THUMB_SIZE_S        60      // Small thumbnail edge (2x2 box-filtered from large)
+#define ART_THUMB_BUDGET_BYTES  (720 * 1024)  // PSRAM budget: 20 slots x 36000 bytes (LRU eviction)
+#define ART_PREFETCH_SLOTS      16      // Queued thumbnail-only art requests (quick-launch grid)
+
+// Persistent art cache (LittleFS on the data partition of default_16MB.csv - kept OTA-compatible)
+#define ART_FLASH_PARTITION     "spiffs"      // Partition label (subtype spiffs, mounted as LittleFS)
+#define ART_FLASH_BASE_PATH     "/artfs"      // VFS mount point
+#define ART_FLASH_QUOTA_BYTES   (3 * 1024 * 1024)  // Max compressed bytes on flash (partition is 3.4MB)
+#define ART_FLASH_MAX_ENTRIES   64      // LRU index capacity (~150KB per compressed frame)
+#define ART_FLASH_WRITE_CHUNK   4096    // Bytes per flash write (yield between chunks)
+
+// HTTP metadata cache (conditional GET + negative results)
+#define ART_HTTP_META_ENTRIES   32      // ETag/Last-Modified entries kept in RAM
+#define ART_REVALIDATE_MS       (30 * 60 * 1000)   // Revalidate a cached frame at most every 30 min
+#define ART_NEG_ENTRIES         32      // Negative cache capacity (oldest replaced)
+#define ART_NEG_TTL_NOT_FOUND_MS  (30 * 60 * 1000)       // 404/410: retry after 30 min
+#define ART_NEG_TTL_OVERSIZE_MS   (6 * 60 * 60 * 1000)   // Too large: retry after 6 h
+#define ART_NEG_TTL_UNSUPPORTED_MS (6 * 60 * 60 * 1000)  // Unsupported/undecodable: 6 h
+
 // =============================================================================
 // SONOS CONTROLLER
 // =============================================================================
 #define SONOS_MAX_DEVICES       10      // Maximum discoverable devices
 #define SONOS_QUEUE_SIZE_MAX    500     // Maximum queue items to fetch
-#define SONOS_QUEUE_BATCH_SIZE  50      // Items per queue fetch request
+#define SONOS_QUEUE_BATCH_SIZE  50      // Items per queue fetch request (one page)
+#define SONOS_QUEUE_PAGE_SLOTS  4       // Resident queue pages (current + next track, list view)
+#define SONOS_QUEUE_ARENA_SIZE  12288   // String arena per queue page in PSRAM (16-bit offsets)
+#define SONOS_QUEUE_INTERN_SLOTS 256    // Intern hash slots per page (power of two, > 3 * batch)
+#define SONOS_QUEUE_EDIT_SLOTS  8       // Queue edits waiting for the network task (sent as one batch)
+#define SONOS_QUEUE_UNPROBED_MS 30000   // Full queue refetch interval while the Q:0 probe keeps failing
 #define SONOS_CMD_QUEUE_SIZE    10      // Command queue depth
-#define SONOS_UI_QUEUE_SIZE     20      // UI update queue depth
+#define SONOS_SOAP_ARGS_MAX     1600    // Max SOAP args bytes (2 KB body buffer, envelope adds ~400)
+#define BROWSE_PAGE_SIZE        50      // Items per ContentDirectory browse page
+#define BROWSE_CACHE_PAGES      6       // Cached browse pages, any folder (LRU)
+#define BROWSE_REQ_SLOTS        8       // Outstanding browse requests to the network task
+#define BROWSE_REVALIDATE_MS    30000   // Re-check a cached folder's UpdateID after this
+#define BROWSE_ID_LEN           128     // Max ContentDirectory ObjectID length
+#define BROWSE_JUMP_SAMPLES     64      // Max titles sampled for a folder's A-Z jump index
+#define BROWSE_JUMP_MIN_ITEMS   100     // Folders smaller than this get no jump index
+#define SONOS_UI_RING_SIZE      32      // UI change-set ring slots (power of two)
 
 // Task configuration (profiled: Net uses ~16KB, Poll uses ~7.5KB of allocated)
 #define SONOS_NET_TASK_STACK    3500    // Network task stack size (was 6144, ~10KB saved)
@@ -95,7 +180,7 @@
 // Polling tick modulos (base interval = 300ms, so N ticks = N * 300ms)
 #define POLL_VOLUME_MODULO      5       // Volume every 1.5s (5 * 300ms)
 #define POLL_TRANSPORT_MODULO   10      // Transport settings every 3s
-#define POLL_QUEUE_MODULO       100     // Queue every 30s (optimized: was 50/15s)
+#define POLL_QUEUE_MODULO       20      // Queue UpdateID probe every 6s (items only refetched on change)
 #define POLL_MEDIA_INFO_MODULO  50      // Radio station info every 15s
 #define POLL_BASE_INTERVAL_MS   300     // Base polling interval
 
@@ -138,6 +223,7 @@
 #define NVS_KEY_OTA_CHANNEL     "ota_channel"
 #define NVS_KEY_CACHED_DEVICE   "cached_dev"
 #define NVS_KEY_LYRICS          "lyrics"
+#define NVS_KEY_PERF_OVERLAY    "perf_overlay"
 
 // =============================================================================
 // UI COLORS (hex values)
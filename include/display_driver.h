@@ -21,5 +21,6 @@ bool display_init(void);
 void display_deinit(void);
 void display_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
 void display_set_brightness(uint8_t brightness_percent);
+void display_log_stats(void);  // Flush bytes/time since last call (periodic heap logging)
 
 #endif // DISPLAY_DRIVER_H
@@ -0,0 +1,19 @@
+/**
+ * Display Rotation Kernel
+ * 90° clockwise RGB565 rotation used by the flush callback (landscape LVGL buffer ->
+ * portrait panel), for full frames and dirty areas alike.
+ *
+ * Plain C (no Arduino/LVGL/ESP-IDF) so it can be benchmarked and tested on a host.
+ */
+
+#ifndef DISPLAY_ROTATE_H
+#define DISPLAY_ROTATE_H
+
+#include <stdint.h>
+
+// Landscape rect (width x height) -> portrait rect (height x width).
+// src_stride/dst_stride are in pixels. src (row r, col c) -> dst (row c, col height - 1 - r)
+void rotate_image_90(const uint16_t *src, int src_stride, int width, int height,
+                     uint16_t *dst, int dst_stride);
+
+#endif // DISPLAY_ROTATE_H
@@ -0,0 +1,29 @@
+/**
+ * Frame Profiler
+ * Per-refresh render / rotate / transfer timings in a ring buffer, an optional
+ * on-screen overlay (General settings) and a CSV dump over serial ("perf").
+ *
+ * Everything runs on the LVGL loop task - no locking.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Hook the display's refresh events (call once after display_init)
+void profilerInit(lv_display_t* disp);
+
+// Called by display_flush for each flushed area
+void profilerNoteFlush(uint32_t rotate_us, uint32_t transfer_us, uint32_t pixels);
+
+// Time spent in lv_timer_handler for one loop() pass
+void profilerNoteLoop(uint32_t handler_us);
+
+// On-screen overlay (FPS, ms per stage, refreshed pixels/s, loop load)
+void profilerSetOverlay(bool enabled);
+bool profilerOverlayEnabled();
+
+// Serial console commands: "perf" dumps the ring buffer as CSV, "bench" / "bench snap"
+// run the UI bench (ui_bench.h)
+void profilerPollSerial();
+void profilerDumpCSV();
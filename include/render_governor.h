@@ -0,0 +1,40 @@
+/**
+ * Render Governor
+ * Picks the LVGL refresh rate from UI activity (active / idle / dimmed) and sleeps
+ * loop() until the next LVGL timer deadline instead of polling every 3 ms.
+ * Touch, Sonos state updates and animations started with governorAnimStart() wake
+ * it to full rate (label scrolling and style transitions do not).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+enum GovernorMode {
+    GOV_ACTIVE = 0,   // Touch, updates or animations in the last GOVERNOR_IDLE_AFTER_MS
+    GOV_IDLE,         // Nothing happening - reduced refresh rate
+    GOV_DIMMED,       // Backlight dimmed by auto-dim - minimum refresh and input rate
+    GOV_MODE_COUNT
+};
+
+// Call from setup() on the loop task, after the display and touch are created
+void governorInit();
+
+// Wake loop() if it is sleeping (e.g. a queued UI update). Safe from any task.
+void governorWake();
+
+// governorWake() + mark UI activity (touch, track change), returning to full rate
+void governorActivity();
+
+// lv_anim_start() for animations that should hold full rate while running (dim
+// fade, lyric fade, background colour fade). Takes over the anim's deleted_cb.
+void governorAnimStart(lv_anim_t* a);
+
+// loop(): after lv_timer_handler() (its return value) - re-evaluates the mode and
+// blocks until the next deadline or a wake. busy_us = time spent in this pass.
+void governorSleep(uint32_t next_timer_ms, uint32_t busy_us);
+
+GovernorMode governorMode();
+
+// Per-mode time share, CPU busy % and wakeups/s (called from periodic heap logging)
+void governorLogStats();
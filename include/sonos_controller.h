@@ -10,9 +10,9 @@
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
+#include "config.h"
 
 #define MAX_SONOS_DEVICES 10
-#define QUEUE_ITEMS_MAX 50  // Keep at 50 for stable performance
 
 // Command queue for network task
 typedef enum {
@@ -28,7 +28,12 @@ typedef enum {
     CMD_PLAY_QUEUE_ITEM,
     CMD_UPDATE_STATE,
     CMD_JOIN_GROUP,
-    CMD_LEAVE_GROUP
+    CMD_LEAVE_GROUP,
+    CMD_FETCH_QUEUE_PAGE,   // value = first queue index of the page
+    CMD_REFRESH_QUEUE,
+    CMD_BROWSE,             // value = browse request slot
+    CMD_BROWSE_JUMP,        // Sample titles for browseJump
+    CMD_QUEUE_EDIT          // Send the pending queue edits, then reconcile
 } SonosCommand_e;
 
 typedef struct {
@@ -37,7 +42,7 @@ typedef struct {
     int32_t value2;  // Secondary value for group commands (target device index)
 } CommandRequest_t;
 
-// UI update notifications
+// Reason passed to notifyUI() (the UI itself only sees SNAP_* change bits)
 typedef enum {
     UPDATE_TRACK_INFO,
     UPDATE_PLAYBACK_STATE,
@@ -49,18 +54,13 @@ typedef enum {
     UPDATE_GROUPS
 } UIUpdateType_e;
 
-typedef struct {
-    UIUpdateType_e type;
-    char message[128];
-} UIUpdate_t;
-
+// Queue item strings are offsets into its page's arena (0 = empty string). Artist,
+// album and art URL are interned per page, so an album's tracks share one copy.
 struct QueueItem {
-    String title;
-    String artist;
-    String album;
-    String duration;
-    int trackNumber;
-    String albumArtURL;
+    uint16_t title;
+    uint16_t artist;
+    uint16_t album;
+    uint16_t albumArtURL;
 };
 
 struct SonosDevice {
@@ -93,11 +93,10 @@ struct SonosDevice {
     String radioStationArtURL;    // Station logo URL (fallback when song has no art)
     String streamContent;         // Current song from r:streamContent (if available)
 
-    // Queue
+    // Queue (items live in the controller's page cache, see QueuePage)
     int currentTrackNumber;
-    int totalTracks;
-    QueueItem queue[QUEUE_ITEMS_MAX];
-    int queueSize;
+    int totalTracks;         // TotalMatches of Q:0
+    int queueSize;           // Items the queue list shows (totalTracks capped at SONOS_QUEUE_SIZE_MAX)
     
     // Connection state
     bool connected;
@@ -110,6 +109,183 @@ struct SonosDevice {
     int groupMemberCount;         // Number of members in this device's group (1 if standalone)
 };
 
+// UI snapshot: fixed-size copy of the current device's playback state. The controller
+// tasks publish it with a sequence lock; the UI copies it without taking deviceMutex.
+#define SNAP_TEXT_LEN   128
+#define SNAP_URL_LEN    512
+
+// Change bits carried by UIChangeSet::mask
+#define SNAP_CONNECTION (1u << 0)   // connected
+#define SNAP_TITLE      (1u << 1)   // title, artist
+#define SNAP_ALBUM      (1u << 2)   // album
+#define SNAP_POSITION   (1u << 3)   // relTime, relTimeSeconds, durationSeconds
+#define SNAP_PLAYSTATE  (1u << 4)   // isPlaying
+#define SNAP_VOLUME     (1u << 5)   // volume
+#define SNAP_MUTE       (1u << 6)   // isMuted
+#define SNAP_SHUFFLE    (1u << 7)   // shuffleMode
+#define SNAP_REPEAT     (1u << 8)   // repeatMode
+#define SNAP_ROOM       (1u << 9)   // roomName
+#define SNAP_NEXT       (1u << 10)  // nextTitle, nextArtist, nextArtURL
+#define SNAP_URI        (1u << 11)  // currentURI
+#define SNAP_ART        (1u << 12)  // albumArtURL, radioStationArtURL
+#define SNAP_RADIO      (1u << 13)  // isRadioStation, radioStationName
+#define SNAP_QUEUE      (1u << 14)  // Queue contents or current track number
+#define SNAP_GROUPS     (1u << 15)  // Group membership (not part of the snapshot)
+#define SNAP_ALL        0xFFFFu
+
+enum SnapRepeat : uint8_t { SNAP_REPEAT_NONE = 0, SNAP_REPEAT_ALL, SNAP_REPEAT_ONE };
+
+struct SonosSnapshot {
+    uint32_t version;            // Publish counter (0 = never published)
+    bool connected;
+    bool isPlaying;
+    bool isMuted;
+    bool shuffleMode;
+    bool isRadioStation;
+    uint8_t repeatMode;          // SnapRepeat
+    int volume;
+    int relTimeSeconds;
+    int durationSeconds;
+    int currentTrackNumber;
+    int queueSize;
+    uint32_t queueVersion;       // Bumped whenever the queue is re-parsed
+    char relTime[12];            // "0:02:15"
+    char title[SNAP_TEXT_LEN];
+    char artist[SNAP_TEXT_LEN];
+    char album[SNAP_TEXT_LEN];
+    char roomName[64];
+    char radioStationName[SNAP_TEXT_LEN];
+    char currentURI[SNAP_URL_LEN];
+    char albumArtURL[SNAP_URL_LEN];
+    char radioStationArtURL[SNAP_URL_LEN];
+    char nextTitle[SNAP_TEXT_LEN];   // Next track from the queue (empty = none / radio)
+    char nextArtist[SNAP_TEXT_LEN];
+    char nextArtURL[SNAP_URL_LEN];
+};
+
+// One publish worth of changes, passed controller -> UI through an SPSC ring.
+// The small fields ride along so the frequent updates (position tick, volume,
+// play state) don't need a full snapshot copy on the UI side.
+#define UI_CS_CONNECTED 0x01
+#define UI_CS_PLAYING   0x02
+#define UI_CS_MUTED     0x04
+#define UI_CS_SHUFFLE   0x08
+
+struct UIChangeSet {
+    uint32_t mask;              // SNAP_* bits that changed
+    int32_t relTimeSeconds;     // Current values at publish time
+    int32_t durationSeconds;
+    int16_t volume;
+    uint8_t repeatMode;         // SnapRepeat
+    uint8_t flags;              // UI_CS_*
+};
+
+// Windowed queue: Q:0 is fetched in pages of SONOS_QUEUE_BATCH_SIZE items and only
+// SONOS_QUEUE_PAGE_SLOTS pages stay resident - around the current track and the
+// queue list's scroll position. The rest is fetched on demand, distant pages evicted.
+struct QueuePage {
+    int start;                  // Queue index of items[0], -1 = free slot
+    int count;
+    uint32_t generation;        // queueGeneration of the refresh that fetched it
+    uint32_t lastUse;           // millis() of the last lookup (eviction tie-break)
+    QueueItem items[SONOS_QUEUE_BATCH_SIZE];
+    char* arena;                // SONOS_QUEUE_ARENA_SIZE bytes, arena[0] = ""
+    uint16_t arenaUsed;
+    uint16_t internSlots[SONOS_QUEUE_INTERN_SLOTS];  // Arena offsets, 0 = empty slot
+
+    const char* str(uint16_t off) const { return arena + off; }
+};
+
+// Queue edit waiting for the network task. It is applied to the resident queue pages
+// when posted; indexes are 0-based and relative to the queue after the edits before it.
+enum QueueEditOp : uint8_t {
+    QUEUE_EDIT_REMOVE,             // RemoveTrackRangeFromQueue [first, first + count)
+    QUEUE_EDIT_MOVE,               // ReorderTracksInQueue [first, first + count) to index `to`
+    QUEUE_EDIT_ADD                 // AddURIToQueue at `first` (EnqueueAsNext when `next`)
+};
+
+struct QueueEdit {
+    uint8_t op;                    // QueueEditOp
+    bool next;
+    bool applied;                  // ADD: already in the local pages (single track)
+    int first;
+    int count;
+    int to;                        // MOVE: final index of the first moved track
+    String uri;                    // ADD
+    String meta;                   // ADD: DIDL-Lite, not XML-escaped
+};
+
+// Fixed-size copy of one queue item for the UI thread
+struct QueueItemView {
+    char title[SNAP_TEXT_LEN];
+    char artist[SNAP_TEXT_LEN];
+    char albumArtURL[SNAP_URL_LEN];
+};
+
+// What tapping a browse row does - decided when the page is indexed
+enum BrowseAction : uint8_t {
+    BROWSE_NONE = 0,               // Nothing playable
+    BROWSE_OPEN,                   // Folder, or a shortcut to one (id/title = target)
+    BROWSE_PLAY_PLAYLIST,          // Top-level Sonos playlist (SQ:n)
+    BROWSE_PLAY_CONTAINER,         // playContainer(uri, meta)
+    BROWSE_PLAY_URI                // playURI(uri, meta)
+};
+
+// One indexed <container>/<item>: offsets of NUL-terminated strings in the page arena
+// (0 = empty). item is the raw DIDL element; meta is item, or the inner DIDL with the
+// outer <res> injected for containers.
+struct BrowseRow {
+    uint32_t item;
+    uint32_t id;
+    uint32_t title;                // Entity-decoded for display
+    uint32_t uri;
+    uint32_t meta;
+    uint32_t art;                  // Absolute album art URL
+    uint8_t action;                // BrowseAction
+    bool container;
+};
+
+// One cached page of a ContentDirectory folder (sonos_browse.cpp)
+struct BrowsePage {
+    char objectID[BROWSE_ID_LEN];  // "" = free slot
+    int start;                     // StartingIndex of the page
+    int count;                     // Rows indexed
+    int total;                     // TotalMatches of the folder
+    uint32_t updateID;             // Folder UpdateID when fetched
+    uint32_t checkedAt;            // millis() of the fetch or the last UpdateID check
+    uint32_t lastUse;
+    char* arena;                   // PSRAM, exactly sized; arena[0] = ""
+    uint32_t arenaSize;
+    BrowseRow rows[BROWSE_PAGE_SIZE];
+
+    const char* str(uint32_t off) const { return arena + off; }
+};
+
+// A-Z jump index of a large folder: sort keys of titles sampled at spaced indexes
+// (a page apart while BROWSE_JUMP_SAMPLES allows), so a letter maps to about one page
+struct BrowseJumpIndex {
+    char objectID[BROWSE_ID_LEN];
+    uint32_t updateID;             // Folder UpdateID the samples belong to
+    int total;
+    int count;                     // Samples
+    int index[BROWSE_JUMP_SAMPLES];
+    char key[BROWSE_JUMP_SAMPLES]; // browseSortKey() of the title at index[i]
+    bool sorted;                   // Keys ascend - the folder is alphabetical
+    bool ready;
+};
+
+// '#' or 'A'-'Z' - the jump index letter of a title
+char browseSortKey(const char* title);
+
+struct BrowseRequest {
+    char objectID[BROWSE_ID_LEN];
+    int start;
+    uint32_t ticket;
+    bool foreground;               // Dropped once a newer foreground request exists
+    bool revalidate;               // Page is cached - only re-check the folder's UpdateID
+    bool pending;                  // Posted, not yet processed
+};
+
 class SonosController {
 private:
     SonosDevice devices[MAX_SONOS_DEVICES];
@@ -122,15 +298,91 @@ private:
     // FreeRTOS synchronization
     SemaphoreHandle_t deviceMutex;
     QueueHandle_t commandQueue;
-    QueueHandle_t uiUpdateQueue;
     TaskHandle_t networkTaskHandle;
     TaskHandle_t pollingTaskHandle;
+
+    // UI snapshot (seqlock - writers serialized by deviceMutex)
+    SonosSnapshot snapshot;          // Published copy read by the UI
+    SonosSnapshot snapshotStage;     // Built under deviceMutex, then published
+    uint32_t snapshotSeq;            // Odd while a publish is in progress
+    uint32_t queueVersion;           // Bumped when resident queue items change
+
+    // Queue page cache (guarded by deviceMutex)
+    QueuePage queuePages[SONOS_QUEUE_PAGE_SLOTS];
+    QueuePage queueStage;            // Parse target; swapped with the slot after the diff
+    uint32_t queueGeneration;        // Bumped per refresh; older pages are dropped after it
+    volatile int queueViewIndex;     // First row the queue list shows (-1 = not shown)
+    uint32_t queuePagePending;       // Bit per page number with a fetch queued by the UI
+    uint32_t queueUpdateID;          // ContentDirectory UpdateID of Q:0 the pages belong to
+    bool queueUpdateIDValid;         // false = unknown, next updateQueue() refetches
+    uint32_t queueUnprobedMs;        // millis() of the last refetch done without a probe (0 = none)
+    int queueDirtyFirst;             // Queue indexes changed since the UI last looked (-1 = none)
+    int queueDirtyLast;
+    QueueEdit queueEdits[SONOS_QUEUE_EDIT_SLOTS];  // Ring, applied locally but not yet sent
+    uint32_t queueEditHead;
+    uint32_t queueEditTail;          // Advanced once an edit has been sent
+    uint32_t queueEditSeq;           // Bumped per edit - fetches parsed before one are stale
+    volatile bool queueEditBusy;     // CMD_QUEUE_EDIT posted, batch not reconciled yet
+    volatile bool queueEditDropPending;  // Batch couldn't be posted - network task drops it
+
+    // Browse cache (guarded by deviceMutex)
+    BrowsePage browsePages[BROWSE_CACHE_PAGES];
+    BrowseRequest browseRequests[BROWSE_REQ_SLOTS];
+    uint32_t browseReqHead;
+    uint32_t browseTicket;           // Last ticket handed out
+    uint32_t browseForeground;       // Ticket of the newest foreground request
+    volatile uint32_t browseFailTicket;  // Last foreground ticket that failed
+    volatile uint32_t browseVersion;     // Bumped when a page lands, is dropped or fails (bumpBrowseVersion)
+    BrowseJumpIndex browseJump;      // Current folder's jump index (built by the network task)
+
+    // saveCurrentTrack() target: resolved once, UpdateID carried over from each add
+    char savePlaylistName[64];
+    char savePlaylistID[BROWSE_ID_LEN];
+    uint32_t savePlaylistUpdateID;
+    bool savePlaylistUpdateIDValid;
+
+    // Change-set ring to the UI (producer side serialized by deviceMutex)
+    UIChangeSet uiRing[SONOS_UI_RING_SIZE];
+    uint32_t uiRingHead;             // Next slot to write (producer)
+    uint32_t uiRingTail;             // Next slot to read (UI)
+    uint32_t uiRingOverflow;         // Bits of change-sets dropped while the ring was full
     
     // Internal methods
     String sendSOAP(const char* service, const char* action, const char* args);
     void getRoomName(SonosDevice* dev);
     int timeToSeconds(const String& time);
     void notifyUI(UIUpdateType_e type);
+    void pushUIChange(uint32_t mask, const SonosSnapshot* st);
+
+    // Queue pages - find/next helpers expect deviceMutex held
+    bool fetchQueuePage(int start);
+    void commitQueuePage(QueuePage* pg);
+    bool probeContainer(const char* objectID, uint32_t* updateID, int* childCount);
+    void markQueueDirty(int first, int last);
+    QueuePage* findQueuePage(int index);
+    QueuePage* allocQueuePage(int start);
+    int nextQueueIndex(const SonosDevice* dev);
+    void resetQueuePages();
+    bool queuePageFull(int start);
+    void shiftQueuePages(int at, int delta, const QueueItemView* inserted, const char* album);
+    void moveQueueTrack(int from, int to);
+    QueueEdit* allocQueueEdit(uint8_t op, bool* kick);
+    void postQueueEdits(bool kick);
+    void dropQueueEdits();
+    bool sendQueueEdit(QueueEdit* e, bool* exact);
+    void processQueueEdits();
+
+    // Browse cache (sonos_browse.cpp) - find/alloc/drop expect deviceMutex held
+    BrowsePage* findBrowseSlot(const char* objectID, int start);
+    BrowsePage* allocBrowseSlot(const char* objectID, int start);
+    void dropBrowseFolder(const char* objectID);
+    // Atomic: failures are reported from both tasks without deviceMutex
+    void bumpBrowseVersion() { __atomic_fetch_add(&browseVersion, 1, __ATOMIC_RELEASE); }
+    bool fetchBrowsePage(const char* objectID, int start);
+    void processBrowse(int slot);
+    bool fetchBrowseKey(const char* objectID, int index, uint32_t updateID, char* key);
+    void buildBrowseJump();
+    bool findPlaylistID(const char* title, char* id, size_t len);
     
     // Task functions
     static void networkTaskFunction(void* parameter);
@@ -173,6 +425,26 @@ public:
     String listMusicServices();  // List available music services
     String getCurrentTrackInfo();  // Get current track URI and metadata for analysis
 
+    // Async browsing (sonos_browse.cpp): folders are fetched in pages of BROWSE_PAGE_SIZE
+    // by the network task and cached per ObjectID. requestBrowse() returns a ticket
+    // (0 = page cached and fresh); getBrowseVersion() bumps whenever a page lands, is
+    // dropped or a request fails. Read pages only between lockBrowse()/unlockBrowse().
+    uint32_t requestBrowse(const char* objectID, int start, bool foreground);
+    bool browseFailed(uint32_t ticket) { return ticket != 0 && ticket == browseFailTicket; }
+    uint32_t getBrowseVersion() { return __atomic_load_n(&browseVersion, __ATOMIC_ACQUIRE); }
+    bool lockBrowse();
+    void unlockBrowse();
+    const BrowsePage* getBrowsePage(const char* objectID, int index);  // Page holding index, or null
+    // Jump index: sampled in the background (one-item browses, cached pages reused);
+    // getBrowseJump() copies it once ready for this folder version
+    void requestBrowseJump(const char* objectID, int total, uint32_t updateID);
+    bool getBrowseJump(const char* objectID, uint32_t updateID, BrowseJumpIndex* out);
+    void resetBrowseCache();
+    // Fill a page directly (UI bench - no network). fill() writes the title and returns
+    // true for a folder row.
+    void injectBrowsePage(const char* objectID, int start, int count, int total,
+                          bool (*fill)(int index, char* title, size_t len));
+
     // Helper methods (public for UI)
     String extractXML(const String& xml, const char* tag);
     String extractXMLRange(const String& xml, const char* tag, int rangeStart, int rangeEnd);
@@ -191,12 +463,43 @@ public:
     bool updateMediaInfo();          // Get station name for radio from GetMediaInfo
     bool updatePlaybackState();
     bool updateVolume();
-    bool updateQueue();
+    bool updateQueue();              // Probe the queue UpdateID; refetch + diff resident pages on change
     bool updateTransportSettings();
+    bool ensureNextQueuePage();      // Fetch the page holding the next track if it isn't resident
+
+    // UI snapshot - publish after changing device state (any task); a publish that
+    // changes anything (or carries extra_bits) pushes a UIChangeSet for the UI.
+    // readSnapshot() copies the latest snapshot lock-free and returns its version.
+    uint32_t publishSnapshot(uint32_t extra_bits = 0);
+    uint32_t readSnapshot(SonosSnapshot* out);
+
+    // UI side of the change-set ring (LVGL thread only). takeUIOverflow() returns
+    // the bits of change-sets dropped on a full ring (re-read them from the snapshot).
+    bool popUIChange(UIChangeSet* out);
+    uint32_t takeUIOverflow();
     
     // Queue access
     QueueHandle_t getCommandQueue() { return commandQueue; }
-    QueueHandle_t getUIUpdateQueue() { return uiUpdateQueue; }
+    uint32_t getQueueVersion() { return queueVersion; }
+
+    // Windowed queue for the UI: copy a resident item (false = not loaded yet), and
+    // report the visible rows so their pages get fetched in the background
+    bool getQueueItem(int index, QueueItemView* out);
+    void setQueueView(int first, int last);
+    void requestQueueRefresh();
+    // Queue indexes whose items changed since the last call (false = none) - the list
+    // rebinds only those rows on a queue version bump
+    bool takeQueueDirtyRange(int* first, int* last);
+    // Queue editing: applied to the resident pages at once, sent in order by the network
+    // task, then reconciled against Q:0's new UpdateID (no refetch when it matches).
+    // false = ring full or bad range; indexes are 0-based.
+    bool removeQueueTracks(int first, int count);
+    bool moveQueueTracks(int first, int count, int to);     // to = final index of the first
+    bool enqueueURI(const char* uri, const char* meta, bool next);  // next = after the current track
+    // Fill a page directly (UI bench - no network)
+    void injectQueuePage(int start, int count, int total, void (*fill)(int index, QueueItemView* item));
+    // Arena usage and interning savings (periodic heap logging)
+    void logQueueStats();
 
     // Task handles for stack monitoring
     TaskHandle_t getNetworkTaskHandle() { return networkTaskHandle; }
@@ -0,0 +1,18 @@
+/**
+ * UI Bench
+ * Replays scripted Sonos state through the real screens with the network tasks
+ * paused, and reports object creation, layout and render cost per screen plus a
+ * pixel hash of each offscreen snapshot, so UI changes can be compared run to run.
+ *
+ * Serial: "bench" prints the report, "bench snap" also dumps every snapshot as a
+ * base64 BMP between "-----BEGIN <name>.bmp-----" / "-----END-----" markers.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+// Record how long a createXxxScreen() took at boot (reported by the bench)
+void uiBenchNoteCreate(const char* screen, uint32_t us);
+
+// Run the bench (LVGL loop task only, blocks for a few seconds)
+void uiBenchRun(bool dump_snapshots);
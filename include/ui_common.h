@@ -73,7 +73,7 @@ extern bool screen_dimmed;
 
 // Screen objects
 extern lv_obj_t *scr_main, *scr_devices, *scr_queue, *scr_settings;
-extern lv_obj_t *scr_wifi, *scr_sources, *scr_browse, *scr_display, *scr_ota, *scr_groups, *scr_general;
+extern lv_obj_t *scr_wifi, *scr_sources, *scr_browse, *scr_search, *scr_display, *scr_ota, *scr_groups, *scr_general;
 
 // Main screen UI elements
 extern lv_obj_t *img_album, *lbl_title, *lbl_artist, *lbl_album, *lbl_time, *lbl_time_remaining;
@@ -106,15 +106,13 @@ extern volatile bool color_ready;
 extern int art_offset_x, art_offset_y;
 extern bool is_sonos_radio_art;
 extern bool pending_is_station_logo;  // True when requesting radio station logo (PNG allowed)
+extern uint32_t pending_art_thumb_key;  // Thumbnail cache key for pending_art_url (pre-rewrite URL)
 extern volatile unsigned long last_queue_fetch_time;  // Track queue fetches for WiFi coordination
 extern SemaphoreHandle_t network_mutex;  // Serializes all WiFi/HTTPS operations (SOAP, album art, OTA)
 extern volatile unsigned long last_network_end_ms;  // Last network operation end time (for SDIO cooldown)
 extern volatile unsigned long last_https_end_ms;   // Last HTTPS operation end time (TLS needs longer cooldown)
 
 // UI state
-extern String ui_title, ui_artist, ui_repeat;
-extern int ui_vol;
-extern bool ui_playing, ui_shuffle, ui_muted;
 extern bool dragging_vol, dragging_prog;
 
 // WiFi state
@@ -157,6 +155,7 @@ void createWiFiScreen();
 void createOTAScreen();
 void createSourcesScreen();
 void createBrowseScreen();
+void createSearchScreen();
 void createGroupsScreen();
 void createGeneralScreen();
 
@@ -165,6 +164,13 @@ void createGeneralScreen();
 // ============================================================================
 void refreshDeviceList();
 void refreshQueueList();
+void syncQueueList(const SonosSnapshot* s);  // Highlight / rebind on SNAP_QUEUE
+void syncBrowseList();  // Bind browse rows as their pages land (every UI pass)
+void syncSearchResults();  // Show search results as they land (every UI pass)
+void activateBrowseItem(const char* objectID, int index);  // Open / play a cached browse row
+void runBrowseAction(uint8_t action, const char* id, const char* title, const char* uri, const char* meta);
+void createLaunchGrid(lv_obj_t* parent);  // Favorites / Playlists tiles (Sources screen)
+void syncLaunchGrid();  // Capture launch pages and thumbnails as they land (every UI pass)
 void refreshGroupsList();
 
 // ============================================================================
@@ -200,11 +206,15 @@ void setBackgroundColor(uint32_t hex_color);
 void setBrightness(int level);
 void resetScreenTimeout();
 void checkAutoDim();
-void requestAlbumArt(const String &url);
+bool requestAlbumArt(const String &url, uint32_t thumbKey = 0);  // false = art task busy, retry
+bool requestArtThumb(const String &url);  // Thumbnail + flash cache only, when the art task is idle
+void artDecodeLogStats();
+void scaleImageBilinear(uint16_t *src, int src_w, int src_h, uint16_t *dst, int dst_w, int dst_h);
 void updateUI();
 void processUpdates();
+uint32_t uiUpdateLastAllocs();  // Heap allocations in the last applied update (alloc_trace.h)
+void uiUpdateLogStats();
 String urlEncode(const char *url);
-void cleanupBrowseData(lv_obj_t *list);
 lv_obj_t *createSettingsSidebar(lv_obj_t *screen, int activeIdx);
 
 // HTML entity decoding helper (inline to avoid code duplication)
@@ -233,6 +243,6 @@ extern volatile bool sonos_tasks_shutdown_requested;
 
 // Radio mode UI adaptation
 void setRadioMode(bool enable);
-void updateRadioModeUI();
+void updateRadioModeUI(const SonosSnapshot* s);
 
 #endif // UI_COMMON_H
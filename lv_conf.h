@@ -204,6 +204,7 @@
  * OTHERS
  *********************/
 #define LV_USE_USER_DATA 1
+#define LV_USE_SNAPSHOT 1                      // Offscreen screen renders for the UI bench
 
 /* Memory attributes */
 #define LV_ATTRIBUTE_FAST_MEM IRAM_ATTR
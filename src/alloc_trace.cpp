@@ -0,0 +1,60 @@
+/**
+ * Allocation Trace
+ * Linker-wrapped allocator entry points; only the armed task is counted, so the
+ * network and art tasks allocating concurrently don't show up.
+ */
+
+#include "alloc_trace.h"
+
+#ifdef UI_ALLOC_TRACE
+
+static TaskHandle_t volatile trace_task = nullptr;
+static volatile uint32_t trace_count = 0;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+static inline void noteAlloc() {
+    // Scheduler may not be running yet for early boot allocations - trace_task is null then
+    if (trace_task && trace_task == xTaskGetCurrentTaskHandle()) trace_count++;
+}
+
+void* __wrap_malloc(size_t size) {
+    noteAlloc();
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    noteAlloc();
+    return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    noteAlloc();
+    return __real_realloc(ptr, size);
+}
+}
+
+void allocTraceBegin() {
+    trace_count = 0;
+    trace_task = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t allocTraceEnd() {
+    trace_task = nullptr;
+    return trace_count;
+}
+
+bool allocTraceEnabled() {
+    return true;
+}
+
+#else
+
+void allocTraceBegin() {}
+uint32_t allocTraceEnd() { return 0; }
+bool allocTraceEnabled() { return false; }
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * Persistent Album Art Cache
+ * LittleFS-backed store of decoded ART_SIZE frames, one file per canonical URL key.
+ *
+ * Compression: QOI-style codec adapted to RGB565 (index / small diff / luma / run /
+ * raw ops). Album art typically compresses to 40-60% and decodes in a few ms,
+ * versus 300ms-2s for a WAN fetch + JPEG decode.
+ *
+ * Eviction: LRU over an in-RAM index persisted to /index.bin on every store.
+ */
+
+#include "art_flash_cache.h"
+#include "ui_common.h"
+#include "config.h"
+#include <LittleFS.h>
+
+#define ART_FLASH_MAGIC     0x31434153  // "SAC1"
+#define ART_FLASH_INDEX     "/index.bin"
+
+// QOI-565 op codes (2-bit tag in the top bits, like QOI)
+#define QOP_INDEX   0x00  // 00iiiiii          - pixel from 64-entry hash table
+#define QOP_DIFF    0x40  // 01rrggbb          - dr/dg/db in -2..1
+#define QOP_LUMA    0x80  // 10gggggg rrrrbbbb - dg in -32..31, dr/db relative to dg/2 in -8..7
+#define QOP_RUN     0xC0  // 11llllll          - repeat previous pixel 1..62 times
+#define QOP_RAW     0xFE  // 0xFE hi lo        - literal RGB565
+
+struct ArtFileHeader {
+    uint32_t magic;
+    uint32_t key;
+    uint16_t width;
+    uint16_t height;
+    uint32_t color;          // Dominant color, so cache hits skip sampling
+    uint32_t payload_size;   // Compressed bytes following the header
+};
+
+struct FlashEntry {
+    uint32_t key;
+    uint32_t size;       // File size on flash (header + payload)
+    uint32_t last_used;  // LRU tick
+};
+
+static FlashEntry flash_index[ART_FLASH_MAX_ENTRIES];
+static int flash_count = 0;
+static uint32_t flash_used_bytes = 0;
+static uint32_t flash_tick = 0;
+static bool flash_mounted = false;
+static bool flash_index_dirty = false;
+
+// Stats
+static uint32_t flash_hits = 0;
+static uint32_t flash_misses = 0;
+static uint32_t flash_load_us_total = 0;
+static uint32_t flash_load_us_max = 0;
+static uint32_t flash_stores = 0;
+static uint32_t flash_evictions = 0;
+static uint32_t flash_bytes_written = 0;
+static uint32_t net_loads = 0;
+static uint32_t net_load_ms_total = 0;
+
+static inline int qoiHash(uint16_t px) {
+    return ((px >> 11) * 3 + ((px >> 5) & 0x3F) * 5 + (px & 0x1F) * 7) & 63;
+}
+
+// Worst case is one RAW op (3 bytes) per pixel
+static size_t qoiMaxSize(int pixels) {
+    return (size_t)pixels * 3;
+}
+
+static size_t qoiEncode(const uint16_t* src, int pixels, uint8_t* out) {
+    uint16_t index[64] = {0};
+    uint16_t prev = 0;
+    int run = 0;
+    size_t n = 0;
+
+    for (int i = 0; i < pixels; i++) {
+        uint16_t px = src[i];
+        if (px == prev) {
+            run++;
+            if (run == 62 || i == pixels - 1) {
+                out[n++] = QOP_RUN | (run - 1);
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out[n++] = QOP_RUN | (run - 1);
+            run = 0;
+        }
+
+        int h = qoiHash(px);
+        if (index[h] == px) {
+            out[n++] = QOP_INDEX | h;
+        } else {
+            index[h] = px;
+            int dr = (int)(px >> 11) - (int)(prev >> 11);
+            int dg = (int)((px >> 5) & 0x3F) - (int)((prev >> 5) & 0x3F);
+            int db = (int)(px & 0x1F) - (int)(prev & 0x1F);
+            int dr_g = dr - dg / 2;
+            int db_g = db - dg / 2;
+
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                out[n++] = QOP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+            } else if (dg >= -32 && dg <= 31 && dr_g >= -8 && dr_g <= 7 && db_g >= -8 && db_g <= 7) {
+                out[n++] = QOP_LUMA | (dg + 32);
+                out[n++] = ((dr_g + 8) << 4) | (db_g + 8);
+            } else {
+                out[n++] = QOP_RAW;
+                out[n++] = px >> 8;
+                out[n++] = px & 0xFF;
+            }
+        }
+        prev = px;
+    }
+    return n;
+}
+
+static bool qoiDecode(const uint8_t* in, size_t len, uint16_t* dst, int pixels) {
+    uint16_t index[64] = {0};
+    uint16_t px = 0;
+    size_t p = 0;
+    int out = 0;
+
+    while (out < pixels && p < len) {
+        uint8_t b = in[p++];
+        if (b == QOP_RAW) {
+            if (p + 2 > len) return false;
+            px = (in[p] << 8) | in[p + 1];
+            p += 2;
+            index[qoiHash(px)] = px;
+        } else if ((b & 0xC0) == QOP_INDEX) {
+            px = index[b & 63];
+        } else if ((b & 0xC0) == QOP_DIFF) {
+            int r = (px >> 11) + ((b >> 4) & 3) - 2;
+            int g = ((px >> 5) & 0x3F) + ((b >> 2) & 3) - 2;
+            int bl = (px & 0x1F) + (b & 3) - 2;
+            px = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (bl & 0x1F);
+            index[qoiHash(px)] = px;
+        } else if ((b & 0xC0) == QOP_LUMA) {
+            if (p + 1 > len) return false;
+            uint8_t b2 = in[p++];
+            int dg = (b & 0x3F) - 32;
+            int r = (px >> 11) + dg / 2 + (b2 >> 4) - 8;
+            int g = ((px >> 5) & 0x3F) + dg;
+            int bl = (px & 0x1F) + dg / 2 + (b2 & 0x0F) - 8;
+            px = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (bl & 0x1F);
+            index[qoiHash(px)] = px;
+        } else {
+            int run = (b & 0x3F) + 1;
+            if (out + run > pixels) return false;
+            while (run--) dst[out++] = px;
+            continue;
+        }
+        dst[out++] = px;
+    }
+    return out == pixels;
+}
+
+static void flashPath(uint32_t key, char* path, size_t len) {
+    snprintf(path, len, "/%08lx.q", (unsigned long)key);
+}
+
+static int findEntry(uint32_t key) {
+    for (int i = 0; i < flash_count; i++) {
+        if (flash_index[i].key == key) return i;
+    }
+    return -1;
+}
+
+static void removeEntry(int i) {
+    char path[16];
+    flashPath(flash_index[i].key, path, sizeof(path));
+    LittleFS.remove(path);
+    flash_used_bytes -= flash_index[i].size;
+    flash_index[i] = flash_index[--flash_count];
+    flash_index_dirty = true;
+}
+
+static void saveIndex() {
+    File f = LittleFS.open(ART_FLASH_INDEX, "w");
+    if (!f) return;
+    f.write((const uint8_t*)&flash_count, sizeof(flash_count));
+    f.write((const uint8_t*)flash_index, sizeof(FlashEntry) * flash_count);
+    f.close();
+    flash_index_dirty = false;
+}
+
+static void loadIndex() {
+    flash_count = 0;
+    flash_used_bytes = 0;
+    File f = LittleFS.open(ART_FLASH_INDEX, "r");
+    if (f) {
+        int count = 0;
+        if (f.read((uint8_t*)&count, sizeof(count)) == sizeof(count) &&
+            count >= 0 && count <= ART_FLASH_MAX_ENTRIES) {
+            if (f.read((uint8_t*)flash_index, sizeof(FlashEntry) * count) == sizeof(FlashEntry) * count) {
+                flash_count = count;
+            }
+        }
+        f.close();
+    }
+    for (int i = 0; i < flash_count; i++) {
+        flash_used_bytes += flash_index[i].size;
+        if (flash_index[i].last_used > flash_tick) flash_tick = flash_index[i].last_used;
+    }
+}
+
+bool initArtFlashCache() {
+    if (flash_mounted) return true;
+    uint32_t t0 = millis();
+    // formatOnFail: first boot (or a corrupted partition) starts with an empty cache
+    if (!LittleFS.begin(true, ART_FLASH_BASE_PATH, 4, ART_FLASH_PARTITION)) {
+        Serial.println("[ARTFS] Mount failed - persistent art cache disabled");
+        return false;
+    }
+    flash_mounted = true;
+    loadIndex();
+    Serial.printf("[ARTFS] Mounted in %lums: %d entries, %luKB / %luKB\n",
+                  millis() - t0, flash_count,
+                  (unsigned long)(flash_used_bytes / 1024), (unsigned long)(ART_FLASH_QUOTA_BYTES / 1024));
+    return true;
+}
+
+bool artFlashLoad(uint32_t key, uint16_t* dst, uint32_t* dominant_color) {
+    if (!flash_mounted || key == 0 || !dst) return false;
+    int idx = findEntry(key);
+    if (idx < 0) {
+        flash_misses++;
+        return false;
+    }
+
+    uint32_t t0 = micros();
+    char path[16];
+    flashPath(key, path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    bool ok = false;
+    if (f) {
+        ArtFileHeader hdr;
+        if (f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+            hdr.magic == ART_FLASH_MAGIC && hdr.key == key &&
+            hdr.width == ART_SIZE && hdr.height == ART_SIZE &&
+            hdr.payload_size <= qoiMaxSize(ART_SIZE * ART_SIZE)) {
+            uint8_t* payload = (uint8_t*)heap_caps_malloc(hdr.payload_size, MALLOC_CAP_SPIRAM);
+            if (payload) {
+                if (f.read(payload, hdr.payload_size) == hdr.payload_size) {
+                    ok = qoiDecode(payload, hdr.payload_size, dst, ART_SIZE * ART_SIZE);
+                    if (ok && dominant_color) *dominant_color = hdr.color;
+                }
+                heap_caps_free(payload);
+            }
+        }
+        f.close();
+    }
+
+    if (!ok) {
+        // Corrupt or missing file - drop it so the next request refetches
+        Serial.printf("[ARTFS] Entry %08lx unreadable, removing\n", (unsigned long)key);
+        removeEntry(idx);
+        saveIndex();
+        flash_misses++;
+        return false;
+    }
+
+    uint32_t us = micros() - t0;
+    flash_hits++;
+    flash_load_us_total += us;
+    if (us > flash_load_us_max) flash_load_us_max = us;
+    flash_index[idx].last_used = ++flash_tick;
+    flash_index_dirty = true;
+    Serial.printf("[ARTFS] Hit %08lx in %lums\n", (unsigned long)key, (unsigned long)(us / 1000));
+    return true;
+}
+
+void artFlashStore(uint32_t key, const uint16_t* src, uint32_t dominant_color) {
+    if (!flash_mounted || key == 0 || !src) return;
+    if (findEntry(key) >= 0) {
+        if (flash_index_dirty) saveIndex();
+        return;
+    }
+
+    const int pixels = ART_SIZE * ART_SIZE;
+    uint8_t* payload = (uint8_t*)heap_caps_malloc(qoiMaxSize(pixels), MALLOC_CAP_SPIRAM);
+    if (!payload) return;
+    uint32_t t0 = millis();
+    size_t payload_size = qoiEncode(src, pixels, payload);
+    uint32_t file_size = sizeof(ArtFileHeader) + payload_size;
+    if (payload_size >= (size_t)pixels * 2) {
+        // Noise-like image - compression doesn't pay off, not worth the flash wear
+        heap_caps_free(payload);
+        return;
+    }
+
+    // Evict LRU entries until the new frame fits the quota
+    while (flash_count > 0 &&
+           (flash_count >= ART_FLASH_MAX_ENTRIES || flash_used_bytes + file_size > ART_FLASH_QUOTA_BYTES)) {
+        int lru = 0;
+        for (int i = 1; i < flash_count; i++) {
+            if (flash_index[i].last_used < flash_index[lru].last_used) lru = i;
+        }
+        removeEntry(lru);
+        flash_evictions++;
+    }
+    if (file_size > ART_FLASH_QUOTA_BYTES) {
+        heap_caps_free(payload);
+        return;
+    }
+
+    char path[16];
+    flashPath(key, path, sizeof(path));
+    File f = LittleFS.open(path, "w");
+    bool ok = false;
+    if (f) {
+        ArtFileHeader hdr = { ART_FLASH_MAGIC, key, ART_SIZE, ART_SIZE, dominant_color, (uint32_t)payload_size };
+        ok = (f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr));
+        // Chunked writes with a yield - flash erase/program stalls the bus
+        for (size_t off = 0; ok && off < payload_size; off += ART_FLASH_WRITE_CHUNK) {
+            size_t chunk = min((size_t)ART_FLASH_WRITE_CHUNK, payload_size - off);
+            ok = (f.write(payload + off, chunk) == chunk);
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        f.close();
+    }
+    heap_caps_free(payload);
+
+    if (!ok) {
+        Serial.println("[ARTFS] Write failed");
+        LittleFS.remove(path);
+        if (flash_index_dirty) saveIndex();
+        return;
+    }
+
+    flash_index[flash_count].key = key;
+    flash_index[flash_count].size = file_size;
+    flash_index[flash_count].last_used = ++flash_tick;
+    flash_count++;
+    flash_used_bytes += file_size;
+    flash_stores++;
+    flash_bytes_written += file_size;
+    saveIndex();
+    Serial.printf("[ARTFS] Stored %08lx: %luKB (%lu%% of raw) in %lums\n",
+                  (unsigned long)key, (unsigned long)(file_size / 1024),
+                  (unsigned long)(payload_size * 100 / (pixels * 2)), millis() - t0);
+}
+
+void artFlashInvalidate(uint32_t key) {
+    if (!flash_mounted) return;
+    int i = findEntry(key);
+    if (i < 0) return;
+    removeEntry(i);
+    saveIndex();
+}
+
+void artFlashNoteNetworkLoad(uint32_t ms) {
+    net_loads++;
+    net_load_ms_total += ms;
+}
+
+void artFlashLogStats() {
+    if (!flash_mounted) return;
+    uint32_t lookups = flash_hits + flash_misses;
+    Serial.printf("[ARTFS] %d entries %luKB | Hits %lu/%lu (%lu%%) | Load avg %lums max %lums | Net avg %lums | Stores %lu (%luKB) | Evict %lu\n",
+                  flash_count, (unsigned long)(flash_used_bytes / 1024),
+                  (unsigned long)flash_hits, (unsigned long)lookups,
+                  (unsigned long)(lookups ? flash_hits * 100 / lookups : 0),
+                  (unsigned long)(flash_hits ? flash_load_us_total / flash_hits / 1000 : 0),
+                  (unsigned long)(flash_load_us_max / 1000),
+                  (unsigned long)(net_loads ? net_load_ms_total / net_loads : 0),
+                  (unsigned long)flash_stores, (unsigned long)(flash_bytes_written / 1024),
+                  (unsigned long)flash_evictions);
+}
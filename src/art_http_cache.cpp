@@ -0,0 +1,169 @@
+/**
+ * Album Art HTTP Metadata Cache
+ * Fixed-size tables, no heap allocation after boot. Only the art task writes them.
+ */
+
+#include "art_http_cache.h"
+#include "config.h"
+
+struct ArtHttpMeta {
+    uint32_t key;            // 0 = empty
+    uint32_t validated_ms;   // Last 200/304 for this key
+    char etag[64];
+    char last_modified[32];
+};
+
+struct ArtNegEntry {
+    uint32_t key;            // 0 = empty
+    uint32_t stored_ms;
+    uint8_t reason;          // ArtNegReason
+};
+
+static ArtHttpMeta http_meta[ART_HTTP_META_ENTRIES];
+static ArtNegEntry neg_cache[ART_NEG_ENTRIES];
+
+// Rolling per-minute byte counters for the last hour
+static uint32_t bytes_per_minute[60];
+static uint32_t bytes_minute = 0;     // Minute index (millis / 60000) of the newest bucket
+static uint32_t bytes_total = 0;      // Since boot
+static uint32_t downloads_total = 0;
+
+// Stats
+static uint32_t neg_hits = 0;
+static uint32_t revalidations = 0;
+static uint32_t not_modified = 0;
+
+static uint32_t negTTL(uint8_t reason) {
+    switch (reason) {
+        case ART_NEG_NOT_FOUND:   return ART_NEG_TTL_NOT_FOUND_MS;
+        case ART_NEG_OVERSIZE:    return ART_NEG_TTL_OVERSIZE_MS;
+        case ART_NEG_UNSUPPORTED: return ART_NEG_TTL_UNSUPPORTED_MS;
+        default:                  return 0;
+    }
+}
+
+const char* artNegReasonName(ArtNegReason reason) {
+    switch (reason) {
+        case ART_NEG_NOT_FOUND:   return "not found";
+        case ART_NEG_OVERSIZE:    return "oversize";
+        case ART_NEG_UNSUPPORTED: return "unsupported";
+        default:                  return "none";
+    }
+}
+
+ArtNegReason artNegLookup(uint32_t key) {
+    if (key == 0) return ART_NEG_NONE;
+    for (int i = 0; i < ART_NEG_ENTRIES; i++) {
+        ArtNegEntry* e = &neg_cache[i];
+        if (e->key != key) continue;
+        if (millis() - e->stored_ms >= negTTL(e->reason)) {
+            e->key = 0;  // Expired - give the URL another chance
+            return ART_NEG_NONE;
+        }
+        neg_hits++;
+        return (ArtNegReason)e->reason;
+    }
+    return ART_NEG_NONE;
+}
+
+void artNegStore(uint32_t key, ArtNegReason reason) {
+    if (key == 0 || reason == ART_NEG_NONE) return;
+    // Reuse the key's slot, else an empty/expired one, else the oldest
+    ArtNegEntry* slot = nullptr;
+    uint32_t now = millis();
+    for (int i = 0; i < ART_NEG_ENTRIES && !slot; i++) {
+        if (neg_cache[i].key == key) slot = &neg_cache[i];
+    }
+    for (int i = 0; i < ART_NEG_ENTRIES && !slot; i++) {
+        ArtNegEntry* e = &neg_cache[i];
+        if (e->key == 0 || now - e->stored_ms >= negTTL(e->reason)) slot = e;
+    }
+    if (!slot) {
+        slot = &neg_cache[0];
+        for (int i = 1; i < ART_NEG_ENTRIES; i++) {
+            if (neg_cache[i].stored_ms < slot->stored_ms) slot = &neg_cache[i];
+        }
+    }
+    slot->key = key;
+    slot->stored_ms = now;
+    slot->reason = reason;
+    Serial.printf("[ART] Negative-cached %08lx (%s)\n", (unsigned long)key, artNegReasonName(reason));
+}
+
+static ArtHttpMeta* findMeta(uint32_t key) {
+    if (key == 0) return nullptr;
+    for (int i = 0; i < ART_HTTP_META_ENTRIES; i++) {
+        if (http_meta[i].key == key) return &http_meta[i];
+    }
+    return nullptr;
+}
+
+void artHttpStoreValidators(uint32_t key, const String& etag, const String& last_modified) {
+    if (key == 0) return;
+    // Stored even without (usable) validators, so the entry still spaces out rechecks
+    bool fits = etag.length() < sizeof(http_meta[0].etag) &&
+                last_modified.length() < sizeof(http_meta[0].last_modified);  // Never send truncated ones
+
+    ArtHttpMeta* m = findMeta(key);
+    if (!m) {
+        // Replace the least recently validated entry
+        m = &http_meta[0];
+        for (int i = 1; i < ART_HTTP_META_ENTRIES && m->key != 0; i++) {
+            if (http_meta[i].key == 0 || http_meta[i].validated_ms < m->validated_ms) m = &http_meta[i];
+        }
+    }
+    m->key = key;
+    m->validated_ms = millis();
+    strcpy(m->etag, fits ? etag.c_str() : "");
+    strcpy(m->last_modified, fits ? last_modified.c_str() : "");
+}
+
+bool artHttpGetValidators(uint32_t key, String& etag, String& last_modified) {
+    ArtHttpMeta* m = findMeta(key);
+    if (!m || (!m->etag[0] && !m->last_modified[0])) return false;
+    etag = m->etag;
+    last_modified = m->last_modified;
+    revalidations++;
+    return true;
+}
+
+// No entry (first showing since boot - the flash cache outlives this table, or the
+// entry was evicted) also counts: the unconditional GET records fresh validators
+bool artHttpNeedsRevalidate(uint32_t key) {
+    ArtHttpMeta* m = findMeta(key);
+    return !m || (millis() - m->validated_ms >= ART_REVALIDATE_MS);
+}
+
+void artHttpMarkValidated(uint32_t key) {
+    ArtHttpMeta* m = findMeta(key);
+    if (m) m->validated_ms = millis();
+    not_modified++;
+}
+
+// Advance the per-minute window, clearing buckets for minutes with no downloads
+static void rollBytesWindow() {
+    uint32_t minute = millis() / 60000;
+    if (minute == bytes_minute) return;
+    uint32_t gap = minute - bytes_minute;
+    for (uint32_t i = 1; i <= gap && i <= 60; i++) {
+        bytes_per_minute[(bytes_minute + i) % 60] = 0;
+    }
+    bytes_minute = minute;
+}
+
+void artHttpNoteBytes(uint32_t bytes) {
+    rollBytesWindow();
+    bytes_per_minute[bytes_minute % 60] += bytes;
+    bytes_total += bytes;
+    downloads_total++;
+}
+
+void artHttpLogStats() {
+    rollBytesWindow();
+    uint32_t last_hour = 0;
+    for (int i = 0; i < 60; i++) last_hour += bytes_per_minute[i];
+    Serial.printf("[ART] Downloaded %luKB last hour, %luKB total (%lu fetches) | 304s %lu/%lu | Neg hits %lu\n",
+                  (unsigned long)(last_hour / 1024), (unsigned long)(bytes_total / 1024),
+                  (unsigned long)downloads_total, (unsigned long)not_modified,
+                  (unsigned long)revalidations, (unsigned long)neg_hits);
+}
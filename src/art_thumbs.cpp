@@ -0,0 +1,221 @@
+/**
+ * Album Art Thumbnail Cache
+ * Fixed pool of PSRAM slots, each holding one 120px + one 60px RGB565 thumbnail.
+ * Written by the art task after a successful decode, read by the LVGL thread.
+ *
+ * Eviction: least-recently-used among unpinned slots. Slots currently shown by a
+ * widget are pinned (ref-counted) so their pixels are never overwritten on screen.
+ */
+
+#include "art_thumbs.h"
+#include "ui_common.h"
+#include "config.h"
+
+#define THUMB_L_PIXELS  (ART_THUMB_SIZE_L * ART_THUMB_SIZE_L)
+#define THUMB_S_PIXELS  (ART_THUMB_SIZE_S * ART_THUMB_SIZE_S)
+#define THUMB_SLOT_BYTES ((THUMB_L_PIXELS + THUMB_S_PIXELS) * 2)
+#define THUMB_SLOT_COUNT (ART_THUMB_BUDGET_BYTES / THUMB_SLOT_BYTES)
+
+struct ThumbSlot {
+    uint32_t key;          // 0 = empty
+    uint32_t last_used;    // LRU tick
+    uint16_t pins;         // Widgets currently displaying this slot
+    bool filling;          // Art task is writing pixels - not visible to lookups
+    uint16_t* pixels;      // [THUMB_L_PIXELS | THUMB_S_PIXELS] in PSRAM
+    lv_image_dsc_t dsc[2]; // Persistent descriptors (LVGL keeps the pointer)
+};
+
+static ThumbSlot thumb_slots[THUMB_SLOT_COUNT];
+static uint16_t* thumb_pool = nullptr;
+static SemaphoreHandle_t thumb_mutex = nullptr;
+static uint32_t thumb_tick = 0;
+static volatile uint32_t thumb_generation = 0;
+
+// Stats
+static uint32_t thumb_hits = 0;
+static uint32_t thumb_misses = 0;
+static uint32_t thumb_stores = 0;
+static uint32_t thumb_evictions = 0;
+static uint32_t thumb_drops = 0;  // Store skipped because every slot was pinned
+
+static void initDsc(lv_image_dsc_t* dsc, const uint16_t* data, int size) {
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->header.w = size;
+    dsc->header.h = size;
+    dsc->header.cf = LV_COLOR_FORMAT_RGB565;
+    dsc->data_size = size * size * 2;
+    dsc->data = (const uint8_t*)data;
+}
+
+void initArtThumbs() {
+    if (thumb_pool) return;
+    thumb_mutex = xSemaphoreCreateMutex();
+    thumb_pool = (uint16_t*)heap_caps_malloc(THUMB_SLOT_COUNT * THUMB_SLOT_BYTES, MALLOC_CAP_SPIRAM);
+    if (!thumb_pool) {
+        Serial.println("[THUMB] ERROR: Failed to allocate thumbnail pool!");
+        return;
+    }
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        ThumbSlot* s = &thumb_slots[i];
+        s->key = 0;
+        s->last_used = 0;
+        s->pins = 0;
+        s->filling = false;
+        s->pixels = thumb_pool + (size_t)i * (THUMB_L_PIXELS + THUMB_S_PIXELS);
+        initDsc(&s->dsc[ART_THUMB_120], s->pixels, ART_THUMB_SIZE_L);
+        initDsc(&s->dsc[ART_THUMB_60], s->pixels + THUMB_L_PIXELS, ART_THUMB_SIZE_S);
+    }
+    Serial.printf("[THUMB] Allocated %d slots (%d bytes) in PSRAM\n",
+                  THUMB_SLOT_COUNT, THUMB_SLOT_COUNT * THUMB_SLOT_BYTES);
+}
+
+// FNV-1a over the URL with scheme and local Sonos host removed
+uint32_t artThumbKey(const char* url) {
+    if (!url || !url[0]) return 0;
+    const char* p = url;
+    if (strncmp(p, "http://", 7) == 0) p += 7;
+    else if (strncmp(p, "https://", 8) == 0) p += 8;
+    if (p != url) {
+        // Local Sonos art ("host:1400/getaa?...") is keyed by path only
+        const char* slash = strchr(p, '/');
+        if (slash && slash - p >= 5 && strncmp(slash - 5, ":1400", 5) == 0) p = slash;
+    }
+    uint32_t h = 2166136261u;
+    while (*p) {
+        h ^= (uint8_t)*p++;
+        h *= 16777619u;
+    }
+    return h ? h : 1;  // 0 is reserved for empty slots
+}
+
+// 2x2 box filter (RGB565), used for the 120 -> 60 mip step
+static void downsample2x(const uint16_t* src, int src_size, uint16_t* dst) {
+    int dst_size = src_size / 2;
+    for (int y = 0; y < dst_size; y++) {
+        const uint16_t* r0 = &src[(y * 2) * src_size];
+        const uint16_t* r1 = r0 + src_size;
+        uint16_t* out = &dst[y * dst_size];
+        for (int x = 0; x < dst_size; x++) {
+            uint16_t a = r0[x * 2], b = r0[x * 2 + 1], c = r1[x * 2], d = r1[x * 2 + 1];
+            int r = ((a >> 11) + (b >> 11) + (c >> 11) + (d >> 11) + 2) >> 2;
+            int g = (((a >> 5) & 0x3F) + ((b >> 5) & 0x3F) + ((c >> 5) & 0x3F) + ((d >> 5) & 0x3F) + 2) >> 2;
+            int bl = ((a & 0x1F) + (b & 0x1F) + (c & 0x1F) + (d & 0x1F) + 2) >> 2;
+            out[x] = (r << 11) | (g << 5) | bl;
+        }
+    }
+}
+
+void artThumbStore(uint32_t key, const uint16_t* art) {
+    if (!thumb_pool || key == 0 || !art) return;
+
+    // Pick a slot: refresh an existing entry, else empty, else LRU unpinned
+    ThumbSlot* victim = nullptr;
+    if (!xSemaphoreTake(thumb_mutex, pdMS_TO_TICKS(50))) return;
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        if (thumb_slots[i].key == key && !thumb_slots[i].filling) {
+            // Already cached (same art replayed) - just bump it
+            thumb_slots[i].last_used = ++thumb_tick;
+            xSemaphoreGive(thumb_mutex);
+            return;
+        }
+    }
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        ThumbSlot* s = &thumb_slots[i];
+        if (s->pins > 0 || s->filling) continue;
+        if (s->key == 0) { victim = s; break; }
+        if (!victim || s->last_used < victim->last_used) victim = s;
+    }
+    if (!victim) {
+        thumb_drops++;
+        xSemaphoreGive(thumb_mutex);
+        return;
+    }
+    if (victim->key != 0) thumb_evictions++;
+    victim->key = 0;
+    victim->filling = true;
+    xSemaphoreGive(thumb_mutex);
+
+    // Scale outside the lock - slot is invisible to lookups while filling
+    scaleImageBilinear((uint16_t*)art, ART_SIZE, ART_SIZE, victim->pixels, ART_THUMB_SIZE_L, ART_THUMB_SIZE_L);
+    downsample2x(victim->pixels, ART_THUMB_SIZE_L, victim->pixels + THUMB_L_PIXELS);
+
+    xSemaphoreTake(thumb_mutex, portMAX_DELAY);
+    victim->key = key;
+    victim->last_used = ++thumb_tick;
+    victim->filling = false;
+    thumb_stores++;
+    thumb_generation++;
+    xSemaphoreGive(thumb_mutex);
+}
+
+void artThumbInvalidate(uint32_t key) {
+    if (!thumb_pool || key == 0) return;
+    xSemaphoreTake(thumb_mutex, portMAX_DELAY);
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        if (thumb_slots[i].key == key && !thumb_slots[i].filling) thumb_slots[i].key = 0;
+    }
+    xSemaphoreGive(thumb_mutex);
+}
+
+const lv_image_dsc_t* artThumbAcquire(uint32_t key, ArtThumbLevel level) {
+    if (!thumb_pool || key == 0) return nullptr;
+    const lv_image_dsc_t* found = nullptr;
+    if (!xSemaphoreTake(thumb_mutex, pdMS_TO_TICKS(10))) return nullptr;
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        ThumbSlot* s = &thumb_slots[i];
+        if (s->key == key && !s->filling) {
+            s->pins++;
+            s->last_used = ++thumb_tick;
+            found = &s->dsc[level];
+            break;
+        }
+    }
+    if (found) thumb_hits++; else thumb_misses++;
+    xSemaphoreGive(thumb_mutex);
+    return found;
+}
+
+void artThumbRelease(const lv_image_dsc_t* dsc) {
+    if (!thumb_pool || !dsc) return;
+    xSemaphoreTake(thumb_mutex, portMAX_DELAY);
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        ThumbSlot* s = &thumb_slots[i];
+        if (dsc == &s->dsc[ART_THUMB_120] || dsc == &s->dsc[ART_THUMB_60]) {
+            if (s->pins > 0) s->pins--;
+            break;
+        }
+    }
+    xSemaphoreGive(thumb_mutex);
+}
+
+static void thumb_delete_cb(lv_event_t* e) {
+    artThumbRelease((const lv_image_dsc_t*)lv_event_get_user_data(e));
+}
+
+lv_obj_t* artThumbCreateImage(lv_obj_t* parent, uint32_t key, ArtThumbLevel level) {
+    const lv_image_dsc_t* dsc = artThumbAcquire(key, level);
+    if (!dsc) return nullptr;
+    lv_obj_t* img = lv_image_create(parent);
+    lv_image_set_src(img, dsc);
+    lv_obj_add_event_cb(img, thumb_delete_cb, LV_EVENT_DELETE, (void*)dsc);
+    return img;
+}
+
+uint32_t artThumbGeneration() {
+    return thumb_generation;
+}
+
+void artThumbLogStats() {
+    if (!thumb_pool) return;
+    int used = 0, pinned = 0;
+    for (int i = 0; i < THUMB_SLOT_COUNT; i++) {
+        if (thumb_slots[i].key != 0) used++;
+        if (thumb_slots[i].pins > 0) pinned++;
+    }
+    uint32_t lookups = thumb_hits + thumb_misses;
+    Serial.printf("[THUMB] Slots %d/%d (pinned %d) | Hits %lu/%lu (%lu%%) | Stores %lu | Evict %lu | Drop %lu\n",
+                  used, THUMB_SLOT_COUNT, pinned,
+                  (unsigned long)thumb_hits, (unsigned long)lookups,
+                  (unsigned long)(lookups ? thumb_hits * 100 / lookups : 0),
+                  (unsigned long)thumb_stores, (unsigned long)thumb_evictions, (unsigned long)thumb_drops);
+}
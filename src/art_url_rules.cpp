@@ -0,0 +1,232 @@
+/**
+ * Album Art URL Rewrite Rules
+ * The URL is split into scheme / host / path / query once, the host is looked up in
+ * the rule table (hash of the registrable domain, then an exact suffix check), and the
+ * output is written left to right with each rule's edits applied in place.
+ */
+
+#include "art_url_rules.h"
+#include "config.h"
+#include <string.h>
+
+// Size negotiation: only ever lower the requested size, never ask a CDN to upscale
+enum ArtSizeAction : uint8_t {
+    SIZE_NONE = 0,
+    SIZE_PATH_DIMS,   // Last path segment starts with "<w>x<h>" (Deezer, Apple Music)
+    SIZE_QUERY_D,     // "d=<edge>" query parameter (TuneIn)
+};
+
+struct ArtUrlRule {
+    const char* domain;       // Last two host labels (hashed for lookup)
+    const char* host;         // Full host suffix, matched on a label boundary
+    bool unwrap_mark;         // Replace URL with its mark= parameter (imgix compositing wrapper)
+    bool downgrade_https;     // Public CDN - fetch over plain HTTP (no TLS on the SDIO link)
+    uint8_t size_action;
+    uint16_t size;            // Target edge for size_action
+};
+
+// Deezer, Apple Music and TuneIn resize on the fly, so the smallest variant that covers
+// the art view is exactly ART_DISPLAY_SIZE. Spotify only serves 64/300/640 and the URL
+// already names 640 - left alone.
+static const ArtUrlRule art_url_rules[] = {
+    { "imgix.net",    "sonosradio.imgix.net",           true,  false, SIZE_NONE,      0 },
+    { "dzcdn.net",    "dzcdn.net",                      false, true,  SIZE_PATH_DIMS, ART_DISPLAY_SIZE },
+    { "mzstatic.com", "mzstatic.com",                   false, false, SIZE_PATH_DIMS, ART_DISPLAY_SIZE },
+    { "tunein.com",   "cdn-profiles.tunein.com",        false, true,  SIZE_QUERY_D,   ART_DISPLAY_SIZE },
+    { "tunein.com",   "cdn-radiotime-logos.tunein.com", false, true,  SIZE_NONE,      0 },
+    { "scdn.co",      "i.scdn.co",                      false, true,  SIZE_NONE,      0 },
+    { "scdn.co",      "mosaic.scdn.co",                 false, true,  SIZE_NONE,      0 },
+};
+#define ART_URL_RULE_COUNT (sizeof(art_url_rules) / sizeof(art_url_rules[0]))
+
+static uint32_t rule_domain_hash[ART_URL_RULE_COUNT];
+static bool rule_hashes_ready = false;
+
+static uint32_t fnv1a(const char* s, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c += 32;
+        h = (h ^ (uint8_t)c) * 16777619u;
+    }
+    return h;
+}
+
+static bool matchesCI(const char* a, const char* b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = a[i];
+        if (c >= 'A' && c <= 'Z') c += 32;
+        if (c != b[i]) return false;
+    }
+    return true;
+}
+
+// Host (port excluded) -> rule, or nullptr
+static const ArtUrlRule* findRule(const char* host, size_t host_len) {
+    if (!rule_hashes_ready) {
+        for (size_t i = 0; i < ART_URL_RULE_COUNT; i++) {
+            rule_domain_hash[i] = fnv1a(art_url_rules[i].domain, strlen(art_url_rules[i].domain));
+        }
+        rule_hashes_ready = true;
+    }
+
+    // Registrable domain = last two labels
+    size_t dots = 0, dom = 0;
+    for (size_t i = host_len; i > 0; i--) {
+        if (host[i - 1] == '.' && ++dots == 2) { dom = i; break; }
+    }
+    uint32_t h = fnv1a(host + dom, host_len - dom);
+
+    for (size_t i = 0; i < ART_URL_RULE_COUNT; i++) {
+        if (rule_domain_hash[i] != h) continue;
+        const char* suffix = art_url_rules[i].host;
+        size_t slen = strlen(suffix);
+        if (slen > host_len) continue;
+        if (slen < host_len && host[host_len - slen - 1] != '.') continue;
+        if (matchesCI(host + host_len - slen, suffix, slen)) return &art_url_rules[i];
+    }
+    return nullptr;
+}
+
+// Bounded output writer - overflow is sticky and reported once at the end
+struct UrlWriter {
+    char* p;
+    char* end;
+    bool overflow;
+
+    void put(const char* s, size_t n) {
+        if (overflow || (size_t)(end - p) < n) { overflow = true; return; }
+        memcpy(p, s, n);
+        p += n;
+    }
+    void put(const char* s) { put(s, strlen(s)); }
+    void putUint(unsigned v) {
+        char tmp[10];
+        int n = 0;
+        do { tmp[n++] = '0' + v % 10; v /= 10; } while (v);
+        while (n) { char c = tmp[--n]; put(&c, 1); }
+    }
+};
+
+// Parse leading decimal digits; returns count consumed
+static size_t parseUint(const char* s, const char* end, unsigned* out) {
+    size_t n = 0;
+    unsigned v = 0;
+    while (s + n < end && s[n] >= '0' && s[n] <= '9' && n < 6) v = v * 10 + (s[n++] - '0');
+    *out = v;
+    return n;
+}
+
+static void rewrite(const char* in, const char* in_end, UrlWriter* w, uint8_t* flags, int depth) {
+    // Scheme
+    bool https = false;
+    const char* host = in;
+    if ((size_t)(in_end - in) >= 8 && memcmp(in, "https://", 8) == 0) { https = true; host = in + 8; }
+    else if ((size_t)(in_end - in) >= 7 && memcmp(in, "http://", 7) == 0) { host = in + 7; }
+
+    // Host[:port] / path / ?query
+    const char* host_end = host;
+    while (host_end < in_end && *host_end != '/' && *host_end != '?') host_end++;
+    const char* port = (const char*)memchr(host, ':', host_end - host);
+    const char* path = host_end;
+    const char* query = (const char*)memchr(path, '?', in_end - path);
+    const char* path_end = query ? query : in_end;
+
+    const ArtUrlRule* rule = (host > in) ? findRule(host, (port ? port : host_end) - host) : nullptr;
+
+    // Sonos Radio: the imgix URL composites the real art (mark=) onto a background
+    if (rule && rule->unwrap_mark && query && depth == 0) {
+        const char* p = query + 1;
+        while (p < in_end) {
+            const char* amp = (const char*)memchr(p, '&', in_end - p);
+            const char* pe = amp ? amp : in_end;
+            if (pe - p > 9 && memcmp(p, "mark=http", 9) == 0) {
+                if (flags) *flags |= ART_URL_UNWRAPPED;
+                rewrite(p + 5, pe, w, flags, depth + 1);
+                return;
+            }
+            p = pe + 1;
+        }
+    }
+
+    // Scheme + host
+    if (host > in) {
+        if (https && rule && rule->downgrade_https) {
+            w->put("http://");
+            if (flags) *flags |= ART_URL_DOWNGRADED;
+        } else {
+            w->put(in, host - in);
+        }
+    }
+    w->put(host, host_end - host);
+
+    // Path (size in the last segment)
+    const char* seg = path;
+    for (const char* p = path; p < path_end; p++) if (*p == '/') seg = p + 1;
+    unsigned dim_w = 0, dim_h = 0;
+    size_t nw = 0, nh = 0;
+    if (rule && rule->size_action == SIZE_PATH_DIMS && seg > path) {
+        nw = parseUint(seg, path_end, &dim_w);
+        if (nw && seg + nw < path_end && seg[nw] == 'x') nh = parseUint(seg + nw + 1, path_end, &dim_h);
+    }
+    if (nh && dim_w > rule->size) {
+        w->put(path, seg - path);
+        w->putUint(rule->size);
+        w->put("x", 1);
+        w->putUint(rule->size);
+        w->put(seg + nw + 1 + nh, path_end - (seg + nw + 1 + nh));
+        if (flags) *flags |= ART_URL_RESIZED;
+    } else {
+        w->put(path, path_end - path);
+    }
+    if (!query) return;
+
+    // Query, one parameter at a time
+    bool getaa = (path_end - path >= 6 && memcmp(path_end - 6, "/getaa", 6) == 0);
+    w->put("?", 1);
+    const char* p = query + 1;
+    while (p <= in_end) {
+        const char* amp = (const char*)memchr(p, '&', in_end - p);
+        const char* pe = amp ? amp : in_end;
+        unsigned d = 0;
+        size_t nd;
+        if (getaa && pe - p >= 2 && memcmp(p, "u=", 2) == 0) {
+            // Sonos getaa: the track URI in u= can carry a raw '?' that breaks the request
+            const char* run = p;
+            for (const char* c = p; c < pe; c++) {
+                if (*c != '?') continue;
+                w->put(run, c - run);
+                w->put("%3F", 3);
+                run = c + 1;
+                if (flags) *flags |= ART_URL_ESCAPED;
+            }
+            w->put(run, pe - run);
+        } else if (rule && rule->size_action == SIZE_QUERY_D && pe - p > 2 && memcmp(p, "d=", 2) == 0 &&
+                   (nd = parseUint(p + 2, pe, &d)) == (size_t)(pe - p - 2) && d > rule->size) {
+            w->put("d=", 2);
+            w->putUint(rule->size);
+            if (flags) *flags |= ART_URL_RESIZED;
+        } else {
+            w->put(p, pe - p);
+        }
+        if (!amp) break;
+        w->put("&", 1);
+        p = pe + 1;
+    }
+}
+
+size_t artRewriteURL(const char* in, char* out, size_t out_len, uint8_t* flags) {
+    if (flags) *flags = 0;
+    if (!out || out_len == 0) return 0;
+    out[0] = '\0';
+    if (!in) return 0;
+
+    UrlWriter w = { out, out + out_len - 1, false };  // Reserve the terminator
+    rewrite(in, in + strlen(in), &w, flags, 0);
+    if (w.overflow) {
+        out[0] = '\0';
+        return 0;
+    }
+    *w.p = '\0';
+    return w.p - out;
+}
@@ -1,20 +1,36 @@
 #include "display_driver.h"
 #include "config.h"
+#include "frame_profiler.h"
+#include "display_rotate.h"
 #include "../lib/st7701_lcd/st7701_lcd.h"
 #include <esp_heap_caps.h>
 #include <esp_lcd_panel_ops.h>
+#include <esp_lcd_mipi_dsi.h>
+#include <esp_timer.h>
 #include <esp_private/esp_cache_private.h>
 #include <driver/ppa.h>
 
 #define USE_PPA_ACCELERATION 0  // Disable hardware acceleration (causes glitches)
+#define USE_PARTIAL_RENDER   1  // Rotate/transfer only invalidated areas (0 = full 800x480 frame per refresh)
 
 static st7701_lcd* lcd = NULL;
 static lv_color_t *buf1 = NULL;
 static lv_color_t *buf2 = NULL;
 static lv_color_t *rotate_buf = NULL;  // Rotation buffer
+static uint16_t *panel_fb = NULL;      // DPI frame buffer (portrait) - partial areas are rotated straight into it
 static lv_display_t *disp = NULL;
 static bsp_lcd_handles_t lcd_handles;
 
+// Flush instrumentation (accumulated per LVGL refresh, reset by display_log_stats)
+static uint32_t stat_frames = 0;
+static uint32_t stat_areas = 0;
+static uint64_t stat_bytes = 0;
+static uint64_t stat_flush_us = 0;
+static uint32_t stat_frame_bytes_max = 0;
+static uint32_t stat_frame_us_max = 0;
+static uint32_t frame_bytes = 0;  // Current refresh (until the last area is flushed)
+static uint32_t frame_us = 0;
+
 #if USE_PPA_ACCELERATION
 static ppa_client_handle_t ppa_handle = NULL;
 static size_t cache_line_size = 0;
@@ -57,32 +73,6 @@ static void rotate_image_90_ppa(const uint16_t *src, uint16_t *dst, int width, i
 }
 #endif
 
-// Software rotation function - rotate landscape 800x480 to portrait 480x800
-static void rotate_image_90(const uint16_t *src, uint16_t *dst, int width, int height) {
-    // Block sizes for cache-efficient rotation
-    constexpr int block_w = 256;
-    constexpr int block_h = 32;
-
-    for (int i = 0; i < height; i += block_h) {
-        int max_height = (i + block_h > height) ? height : (i + block_h);
-
-        for (int j = 0; j < width; j += block_w) {
-            int max_width = (j + block_w > width) ? width : (j + block_w);
-
-            for (int x = i; x < max_height; x++) {
-                for (int y = j; y < max_width; y++) {
-                    // Source pixel at (x, y) -> reading as (row, col)
-                    const uint16_t *src_pixel = src + (x * width + y);
-
-                    // 90° rotation formula from reference: (x, y) -> (y, height - 1 - x)
-                    uint16_t *dst_pixel = dst + (y * height + (height - 1 - x));
-                    *dst_pixel = *src_pixel;
-                }
-            }
-        }
-    }
-}
-
 bool display_init(void) {
     Serial.println("[Display] Initializing MIPI DSI interface for ST7701...");
 
@@ -113,13 +103,27 @@ bool display_init(void) {
 
     Serial.println("[Display] ST7701 LCD initialized successfully");
 
+#if USE_PARTIAL_RENDER
+    // Rotate dirty areas directly into the panel's DPI frame buffer (no intermediate copy)
+    void *fb = NULL;
+    if (esp_lcd_dpi_panel_get_frame_buffer(lcd_handles.panel, 1, &fb) == ESP_OK && fb) {
+        panel_fb = (uint16_t *)fb;
+        Serial.printf("[Display] Partial render: rotating into DPI frame buffer at %p\n", fb);
+    } else {
+        Serial.println("[Display] WARNING: DPI frame buffer unavailable, partial areas go through rotate buffer");
+    }
+#endif
+
     // Allocate LVGL buffers in PSRAM - LANDSCAPE dimensions for LVGL (800x480)
     buf1 = (lv_color_t *)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     buf2 = (lv_color_t *)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     // Allocate rotation buffer - PORTRAIT dimensions for panel (480x800)
-    rotate_buf = (lv_color_t *)heap_caps_malloc(DISPLAY_HEIGHT * DISPLAY_WIDTH * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    // Not needed when partial areas rotate straight into the DPI frame buffer
+    if (!panel_fb) {
+        rotate_buf = (lv_color_t *)heap_caps_malloc(DISPLAY_HEIGHT * DISPLAY_WIDTH * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    }
 
-    if (!buf1 || !buf2 || !rotate_buf) {
+    if (!buf1 || !buf2 || (!rotate_buf && !panel_fb)) {
         Serial.println("[Display] ERROR: Failed to allocate buffers!");
         if (buf1) heap_caps_free(buf1);
         if (buf2) heap_caps_free(buf2);
@@ -129,8 +133,10 @@ bool display_init(void) {
 
     Serial.printf("[Display] LVGL buffers: %d bytes each (landscape %dx%d)\n",
                   DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t), DISPLAY_WIDTH, DISPLAY_HEIGHT);
-    Serial.printf("[Display] Rotate buffer: %d bytes (portrait %dx%d)\n",
-                  PANEL_WIDTH * PANEL_HEIGHT * sizeof(lv_color_t), PANEL_WIDTH, PANEL_HEIGHT);
+    if (rotate_buf) {
+        Serial.printf("[Display] Rotate buffer: %d bytes (portrait %dx%d)\n",
+                      PANEL_WIDTH * PANEL_HEIGHT * sizeof(lv_color_t), PANEL_WIDTH, PANEL_HEIGHT);
+    }
     Serial.printf("[Display] Free PSRAM: %d bytes\n", heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
 
     // LVGL v9 display initialization - Create as LANDSCAPE (800x480)
@@ -142,11 +148,20 @@ bool display_init(void) {
     }
 
     lv_display_set_flush_cb(disp, display_flush);
+    // Buffers stay full-size in partial mode so any dirty area renders (and flushes) in one piece
+#if USE_PARTIAL_RENDER
+    lv_display_set_buffers(disp, buf1, buf2, DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#else
     lv_display_set_buffers(disp, buf1, buf2, DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_FULL);
+#endif
 
     // DON'T use lv_display_set_rotation - we do rotation manually in flush callback
 
+#if USE_PARTIAL_RENDER
+    Serial.println("[Display] Ready! 800x480 landscape, dirty areas rotated to portrait panel");
+#else
     Serial.println("[Display] Ready! 800x480 landscape with manual 90° rotation to portrait panel");
+#endif
     return true;
 }
 
@@ -159,11 +174,34 @@ void display_set_brightness(uint8_t brightness_percent) {
 }
 
 void display_flush(lv_display_t *disp_drv, const lv_area_t *area, uint8_t *px_map) {
-    if (!lcd || !lcd_handles.panel || !rotate_buf) {
+    if (!lcd || !lcd_handles.panel || (!rotate_buf && !panel_fb)) {
         lv_display_flush_ready(disp_drv);
         return;
     }
+    uint32_t t0 = (uint32_t)esp_timer_get_time();
+    uint32_t t_rot = 0;  // End of rotation / start of panel transfer
+
+#if USE_PARTIAL_RENDER
+    // Landscape area (cols x1..x2, rows y1..y2) -> portrait cols (479-y2)..(479-y1), rows x1..x2
+    int w = lv_area_get_width(area);
+    int h = lv_area_get_height(area);
+    int src_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565) / sizeof(uint16_t);
+    int px = DISPLAY_HEIGHT - 1 - area->y2;
+    int py = area->x1;
 
+    if (panel_fb) {
+        // Rotate into place; draw_bitmap on the panel's own buffer only writes back the cache lines
+        rotate_image_90((uint16_t *)px_map, src_stride, w, h, panel_fb + py * PANEL_WIDTH + px, PANEL_WIDTH);
+        t_rot = (uint32_t)esp_timer_get_time();
+        lcd->lcd_draw_bitmap(px, py, px + h, py + w, panel_fb);
+    } else {
+        // Compact h x w rect, copied into the frame buffer by the DPI driver
+        rotate_image_90((uint16_t *)px_map, src_stride, w, h, (uint16_t *)rotate_buf, h);
+        t_rot = (uint32_t)esp_timer_get_time();
+        lcd->lcd_draw_bitmap(px, py, px + h, py + w, (uint16_t *)rotate_buf);
+    }
+    uint32_t pixels = (uint32_t)w * h;
+#else
     // Rotate the entire frame from landscape 800x480 to portrait 480x800 for panel
     // Panel DPI is now configured for 480×800 portrait
 #if USE_PPA_ACCELERATION
@@ -172,19 +210,53 @@ void display_flush(lv_display_t *disp_drv, const lv_area_t *area, uint8_t *px_ma
         rotate_image_90_ppa((uint16_t *)px_map, (uint16_t *)rotate_buf, DISPLAY_WIDTH, DISPLAY_HEIGHT);
     } else {
         // Fallback to software rotation
-        rotate_image_90((uint16_t *)px_map, (uint16_t *)rotate_buf, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        rotate_image_90((uint16_t *)px_map, DISPLAY_WIDTH, DISPLAY_WIDTH, DISPLAY_HEIGHT, (uint16_t *)rotate_buf, DISPLAY_HEIGHT);
     }
 #else
     // Software rotation only
-    rotate_image_90((uint16_t *)px_map, (uint16_t *)rotate_buf, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    rotate_image_90((uint16_t *)px_map, DISPLAY_WIDTH, DISPLAY_WIDTH, DISPLAY_HEIGHT, (uint16_t *)rotate_buf, DISPLAY_HEIGHT);
 #endif
 
     // Send rotated buffer to panel in portrait orientation
+    t_rot = (uint32_t)esp_timer_get_time();
     lcd->lcd_draw_bitmap(0, 0, PANEL_WIDTH, PANEL_HEIGHT, (uint16_t *)rotate_buf);
+    uint32_t pixels = DISPLAY_WIDTH * DISPLAY_HEIGHT;
+#endif
+    uint32_t t_end = (uint32_t)esp_timer_get_time();
+    profilerNoteFlush(t_rot - t0, t_end - t_rot, pixels);
+    uint32_t bytes = pixels * sizeof(uint16_t);
+
+    // Bytes rotated/transferred and time spent, summed over the areas of one refresh
+    stat_areas++;
+    frame_bytes += bytes;
+    frame_us += t_end - t0;
+    if (lv_display_flush_is_last(disp_drv)) {
+        stat_frames++;
+        stat_bytes += frame_bytes;
+        stat_flush_us += frame_us;
+        if (frame_bytes > stat_frame_bytes_max) stat_frame_bytes_max = frame_bytes;
+        if (frame_us > stat_frame_us_max) stat_frame_us_max = frame_us;
+        frame_bytes = 0;
+        frame_us = 0;
+    }
 
     lv_display_flush_ready(disp_drv);
 }
 
+void display_log_stats(void) {
+    if (stat_frames == 0) return;
+    Serial.printf("[Display] %lu frames, %lu areas | avg %luKB/frame (max %luKB) | flush avg %luus (max %luus)\n",
+                  (unsigned long)stat_frames, (unsigned long)stat_areas,
+                  (unsigned long)(stat_bytes / stat_frames / 1024), (unsigned long)(stat_frame_bytes_max / 1024),
+                  (unsigned long)(stat_flush_us / stat_frames), (unsigned long)stat_frame_us_max);
+    stat_frames = 0;
+    stat_areas = 0;
+    stat_bytes = 0;
+    stat_flush_us = 0;
+    stat_frame_bytes_max = 0;
+    stat_frame_us_max = 0;
+}
+
 // Cleanup function to free all display resources
 void display_deinit() {
     if (lcd) {
@@ -203,6 +275,7 @@ void display_deinit() {
         heap_caps_free(rotate_buf);
         rotate_buf = NULL;
     }
+    panel_fb = NULL;
 #if USE_PPA_ACCELERATION
     if (ppa_handle) {
         ppa_unregister_client(ppa_handle);
@@ -0,0 +1,43 @@
+/**
+ * Display Rotation Kernel
+ * Tiled transpose: 32x32 tiles, each destination row written as 32-bit pixel pairs.
+ */
+
+#include "display_rotate.h"
+
+// Rotation tile edge: one tile row is 32 px x 2 bytes = a 64-byte P4 L1 cache line, and a
+// 32x32 tile's source + destination lines (4 KB) stay resident while it is transposed
+#define ROTATE_TILE 32
+
+typedef uint32_t __attribute__((may_alias)) rotate_word_t;
+
+// One destination row of a tile: n pixels walking *up* the source column from s,
+// written as 32-bit pixel pairs (a leading/trailing pixel covers odd alignment/length)
+static inline void rotate_tile_row(uint16_t *d, const uint16_t *s, int src_stride, int n) {
+    int j = 0;
+    if (((uintptr_t)d & 2) && n > 0) {
+        d[0] = s[0];
+        j = 1;
+    }
+    rotate_word_t *d32 = (rotate_word_t *)(d + j);
+    for (; j + 1 < n; j += 2) {
+        *d32++ = (uint32_t)s[-j * src_stride] | ((uint32_t)s[-(j + 1) * src_stride] << 16);
+    }
+    if (j < n) d[j] = s[-j * src_stride];
+}
+
+void rotate_image_90(const uint16_t *src, int src_stride, int width, int height,
+                     uint16_t *dst, int dst_stride) {
+    for (int r0 = 0; r0 < height; r0 += ROTATE_TILE) {
+        int rn = (r0 + ROTATE_TILE > height) ? (height - r0) : ROTATE_TILE;
+        const uint16_t *src_last_row = src + (r0 + rn - 1) * src_stride;
+        uint16_t *dst_tile = dst + (height - r0 - rn);
+
+        for (int c0 = 0; c0 < width; c0 += ROTATE_TILE) {
+            int cn = (c0 + ROTATE_TILE > width) ? (width - c0) : ROTATE_TILE;
+            for (int c = c0; c < c0 + cn; c++) {
+                rotate_tile_row(dst_tile + c * dst_stride, src_last_row + c, src_stride, rn);
+            }
+        }
+    }
+}
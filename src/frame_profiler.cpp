@@ -0,0 +1,160 @@
+/**
+ * Frame Profiler
+ * A refresh runs from LV_EVENT_REFR_START to LV_EVENT_REFR_READY; flush hooks add the
+ * rotate/transfer share, the remainder is LVGL rendering. Refreshes with nothing to
+ * draw are not recorded.
+ */
+
+#include "frame_profiler.h"
+#include "config.h"
+#include "ui_bench.h"
+#include <esp_timer.h>
+
+struct FrameSample {
+    uint32_t ms;           // millis() at refresh end
+    uint32_t refresh_us;   // Whole refresh pass
+    uint32_t render_us;    // refresh_us minus rotate + transfer
+    uint32_t rotate_us;
+    uint32_t transfer_us;
+    uint32_t pixels;       // Refreshed (flushed) pixels
+    uint16_t areas;
+};
+
+static FrameSample ring[PROFILER_RING_SIZE];
+static uint32_t ring_head = 0;    // Next write index
+static uint32_t ring_count = 0;
+
+// Refresh in progress
+static uint32_t refr_start_us = 0;
+static FrameSample cur;
+
+// Loop load, accumulated between overlay updates
+static uint32_t loop_busy_us = 0;
+static uint32_t loop_passes = 0;
+static uint32_t loop_window_start_us = 0;
+
+static lv_obj_t* overlay_label = nullptr;
+static lv_timer_t* overlay_timer = nullptr;
+
+static char serial_cmd[16];
+static uint8_t serial_cmd_len = 0;
+
+static void refr_event_cb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_REFR_START) {
+        refr_start_us = (uint32_t)esp_timer_get_time();
+        memset(&cur, 0, sizeof(cur));
+    } else if (code == LV_EVENT_REFR_READY) {
+        if (cur.areas == 0) return;  // Nothing was invalidated
+        cur.ms = millis();
+        cur.refresh_us = (uint32_t)esp_timer_get_time() - refr_start_us;
+        uint32_t flush_us = cur.rotate_us + cur.transfer_us;
+        cur.render_us = cur.refresh_us > flush_us ? cur.refresh_us - flush_us : 0;
+        ring[ring_head] = cur;
+        ring_head = (ring_head + 1) % PROFILER_RING_SIZE;
+        if (ring_count < PROFILER_RING_SIZE) ring_count++;
+    }
+}
+
+void profilerInit(lv_display_t* disp) {
+    if (!disp) return;
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+    loop_window_start_us = (uint32_t)esp_timer_get_time();
+}
+
+void profilerNoteFlush(uint32_t rotate_us, uint32_t transfer_us, uint32_t pixels) {
+    cur.rotate_us += rotate_us;
+    cur.transfer_us += transfer_us;
+    cur.pixels += pixels;
+    cur.areas++;
+}
+
+void profilerNoteLoop(uint32_t handler_us) {
+    loop_busy_us += handler_us;
+    loop_passes++;
+}
+
+// Summarize the last second of samples into the overlay label
+static void overlay_timer_cb(lv_timer_t* t) {
+    if (!overlay_label) return;
+    uint32_t now = millis();
+    uint32_t frames = 0, pixels = 0, render = 0, rotate = 0, transfer = 0, worst = 0;
+    for (uint32_t i = 0; i < ring_count; i++) {
+        const FrameSample* s = &ring[(ring_head + PROFILER_RING_SIZE - 1 - i) % PROFILER_RING_SIZE];
+        if (now - s->ms > 1000) break;  // Newest first - everything after is older
+        frames++;
+        pixels += s->pixels;
+        render += s->render_us;
+        rotate += s->rotate_us;
+        transfer += s->transfer_us;
+        if (s->refresh_us > worst) worst = s->refresh_us;
+    }
+
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    uint32_t window_us = now_us - loop_window_start_us;
+    uint32_t load_pct = window_us ? (uint32_t)((uint64_t)loop_busy_us * 100 / window_us) : 0;
+    loop_window_start_us = now_us;
+    loop_busy_us = 0;
+    uint32_t passes = loop_passes;
+    loop_passes = 0;
+
+    uint32_t n = frames ? frames : 1;
+    lv_label_set_text_fmt(overlay_label,
+                          "%lu fps  %lu kpx/s\nrender %lu.%lu  rot %lu.%lu  xfer %lu.%lu ms\nworst %lu.%lu ms  loop %lu%% (%lu/s)",
+                          (unsigned long)frames, (unsigned long)(pixels / 1000),
+                          (unsigned long)(render / n / 1000), (unsigned long)(render / n / 100 % 10),
+                          (unsigned long)(rotate / n / 1000), (unsigned long)(rotate / n / 100 % 10),
+                          (unsigned long)(transfer / n / 1000), (unsigned long)(transfer / n / 100 % 10),
+                          (unsigned long)(worst / 1000), (unsigned long)(worst / 100 % 10),
+                          (unsigned long)load_pct, (unsigned long)passes);
+}
+
+void profilerSetOverlay(bool enabled) {
+    if (enabled && !overlay_label) {
+        overlay_label = lv_label_create(lv_layer_top());
+        lv_obj_set_style_text_font(overlay_label, &lv_font_montserrat_12, 0);
+        lv_obj_set_style_text_color(overlay_label, lv_color_hex(COLOR_SUCCESS), 0);
+        lv_obj_set_style_bg_color(overlay_label, lv_color_hex(COLOR_BACKGROUND), 0);
+        lv_obj_set_style_bg_opa(overlay_label, LV_OPA_70, 0);
+        lv_obj_set_style_pad_all(overlay_label, 4, 0);
+        lv_obj_align(overlay_label, LV_ALIGN_BOTTOM_RIGHT, -4, -4);
+        lv_label_set_text(overlay_label, "profiling...");
+        overlay_timer = lv_timer_create(overlay_timer_cb, 1000, NULL);
+    } else if (!enabled && overlay_label) {
+        lv_timer_delete(overlay_timer);
+        overlay_timer = nullptr;
+        lv_obj_delete(overlay_label);
+        overlay_label = nullptr;
+    }
+}
+
+bool profilerOverlayEnabled() {
+    return overlay_label != nullptr;
+}
+
+void profilerDumpCSV() {
+    Serial.println("ms,refresh_us,render_us,rotate_us,transfer_us,areas,pixels");
+    uint32_t oldest = (ring_head + PROFILER_RING_SIZE - ring_count) % PROFILER_RING_SIZE;
+    for (uint32_t i = 0; i < ring_count; i++) {
+        const FrameSample* s = &ring[(oldest + i) % PROFILER_RING_SIZE];
+        Serial.printf("%lu,%lu,%lu,%lu,%lu,%u,%lu\n", (unsigned long)s->ms, (unsigned long)s->refresh_us,
+                      (unsigned long)s->render_us, (unsigned long)s->rotate_us, (unsigned long)s->transfer_us,
+                      (unsigned)s->areas, (unsigned long)s->pixels);
+    }
+}
+
+void profilerPollSerial() {
+    while (Serial.available() > 0) {
+        char c = (char)Serial.read();
+        if (c == '\r' || c == '\n') {
+            serial_cmd[serial_cmd_len] = '\0';
+            if (strcmp(serial_cmd, "perf") == 0) profilerDumpCSV();
+            else if (strcmp(serial_cmd, "bench") == 0) uiBenchRun(false);
+            else if (strcmp(serial_cmd, "bench snap") == 0) uiBenchRun(true);
+            serial_cmd_len = 0;
+        } else if (serial_cmd_len < sizeof(serial_cmd) - 1) {
+            serial_cmd[serial_cmd_len++] = c;
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include "lyrics.h"
 #include "ui_common.h"
 #include "config.h"
+#include "render_governor.h"
 #include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
@@ -338,6 +339,7 @@ static void lyricsTaskFunc(void* param) {
 
     lyrics_fetching = false;
     // Status will be updated by main UI loop
+    governorWake();
     lyricsTaskHandle = NULL;  // Clear handle before self-deletion
     vTaskDelete(NULL);
 }
@@ -527,7 +529,7 @@ void updateLyricsDisplay(int position_seconds) {
         lv_anim_set_duration(&anim, 150);
         lv_anim_set_exec_cb(&anim, lyrics_fade_cb);
         lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
-        lv_anim_start(&anim);
+        governorAnimStart(&anim);
     }
 
     // Color current line with brightened dominant color (brighter than progress bar)
@@ -555,15 +557,15 @@ void updateLyricsStatus() {
 
     if (!lbl_lyrics_status) return;
     if (!lyrics_enabled) {
-        lv_label_set_text(lbl_lyrics_status, "");  // Hide when disabled
+        lv_label_set_text_static(lbl_lyrics_status, "");  // Hide when disabled
         return;
     }
 
     // Only show status when fetching, hide otherwise
     if (lyrics_fetching) {
-        lv_label_set_text(lbl_lyrics_status, "Fetching lyrics...");
+        lv_label_set_text_static(lbl_lyrics_status, "Fetching lyrics...");
         lv_obj_set_style_text_color(lbl_lyrics_status, lv_color_hex(0x666666), 0);  // Dark gray, subtle
     } else {
-        lv_label_set_text(lbl_lyrics_status, "");  // Hide when ready or no lyrics
+        lv_label_set_text_static(lbl_lyrics_status, "");  // Hide when ready or no lyrics
     }
 }
@@ -7,6 +7,12 @@
 #include "ui_common.h"
 #include "config.h"
 #include "lyrics.h"
+#include "art_thumbs.h"
+#include "art_flash_cache.h"
+#include "art_http_cache.h"
+#include "frame_profiler.h"
+#include "render_governor.h"
+#include "ui_bench.h"
 #include <esp_flash.h>
 #include <esp_task_wdt.h>
 
@@ -91,8 +97,11 @@ void setup() {
     }
 
     lv_init();
+    lv_tick_set_cb(millis);  // Tick from the system clock - loop() no longer runs at a fixed rate
     if (!display_init()) { Serial.println("Display FAIL"); while(1) delay(1000); }
     if (!touch_init()) { Serial.println("Touch FAIL"); while(1) delay(1000); }
+    profilerInit(lv_display_get_default());
+    governorInit();
 
     // Initialize hardware watchdog timer - auto-reboot if system hangs
     esp_task_wdt_config_t wdt_config = {
@@ -161,35 +170,43 @@ void setup() {
     // Initialize lyrics PSRAM buffer before creating screens
     initLyrics();
 
-    createMainScreen();
+    // Screen creation times are kept for the UI bench ("bench" on serial)
+    auto timedCreate = [](const char* name, void (*create)()) {
+        uint32_t t0 = micros();
+        create();
+        uiBenchNoteCreate(name, micros() - t0);
+    };
+
+    timedCreate("main", createMainScreen);
     updateBootProgress(35);
 
-    createDevicesScreen();
+    timedCreate("devices", createDevicesScreen);
     updateBootProgress(45);
 
-    createQueueScreen();
+    timedCreate("queue", createQueueScreen);
     updateBootProgress(55);
 
     createSettingsScreen();
     updateBootProgress(65);
 
-    createDisplaySettingsScreen();
+    timedCreate("display", createDisplaySettingsScreen);
     updateBootProgress(70);
 
-    createWiFiScreen();
+    timedCreate("wifi", createWiFiScreen);
     updateBootProgress(75);
 
-    createOTAScreen();
+    timedCreate("ota", createOTAScreen);
     updateBootProgress(80);
 
-    createSourcesScreen();
+    timedCreate("sources", createSourcesScreen);
     updateBootProgress(83);
 
-    createGroupsScreen();
-    createGeneralScreen();
+    timedCreate("groups", createGroupsScreen);
+    timedCreate("general", createGeneralScreen);
     updateBootProgress(85);
 
     art_mutex = xSemaphoreCreateMutex();
+    initArtThumbs();
     xTaskCreatePinnedToCore(albumArtTask, "Art", ART_TASK_STACK_SIZE, NULL, ART_TASK_PRIORITY, &albumArtTaskHandle, 0);
     updateBootProgress(90);
 
@@ -214,6 +231,7 @@ void setup() {
     delay(300);  // Show 100% briefly
 
     lv_screen_load(scr_main);  // Now load main screen
+    profilerSetOverlay(wifiPrefs.getBool(NVS_KEY_PERF_OVERLAY, false));
     Serial.println("Ready!");
 }
 
@@ -242,8 +260,13 @@ void logHeapStatus() {
     size_t min_heap = esp_get_minimum_free_heap_size();
     size_t free_psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
 
-    Serial.printf("[HEAP] Free: %dKB | Min: %dKB | PSRAM: %dKB\n",
-                  free_heap / 1024, min_heap / 1024, free_psram / 1024);
+    // Fragmentation: share of free internal heap not usable as one block
+    size_t free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    int frag = free_internal ? (int)(100 - largest * 100 / free_internal) : 0;
+
+    Serial.printf("[HEAP] Free: %dKB | Min: %dKB | PSRAM: %dKB | Largest: %dKB (frag %d%%)\n",
+                  free_heap / 1024, min_heap / 1024, free_psram / 1024, largest / 1024, frag);
 
     // Log task stack high water marks (unused stack space in words)
     // Lower number = more stack used, closer to overflow
@@ -252,6 +275,15 @@ void logHeapStatus() {
     Serial.printf("Net:%d ", sonos.getNetworkTaskHandle() ? uxTaskGetStackHighWaterMark(sonos.getNetworkTaskHandle()) * 4 : 0);
     Serial.printf("Poll:%d bytes free\n", sonos.getPollingTaskHandle() ? uxTaskGetStackHighWaterMark(sonos.getPollingTaskHandle()) * 4 : 0);
 
+    artThumbLogStats();
+    artFlashLogStats();
+    artHttpLogStats();
+    artDecodeLogStats();
+    display_log_stats();
+    governorLogStats();
+    uiUpdateLogStats();
+    sonos.logQueueStats();
+
     // Warn if heap is getting low
     if (free_heap < 50000) {
         Serial.println("[HEAP] WARNING: Low memory!");
@@ -261,8 +293,7 @@ void logHeapStatus() {
 void loop() {
     // Feed watchdog to prevent reboot (must call regularly)
     esp_task_wdt_reset();
-
-    lv_tick_inc(3);
+    uint32_t pass_start = micros();
 
     // Skip LVGL timer during OTA to prevent PSRAM access during flash writes
     bool skip_updates = false;
@@ -271,13 +302,20 @@ void loop() {
         xSemaphoreGive(ota_progress_mutex);
     }
 
-    if (!skip_updates) {
-        lv_timer_handler();
-        processUpdates();
-        checkAutoDim();
-        checkWiFiReconnect();
-        logHeapStatus();  // Periodic memory monitoring
+    if (skip_updates) {
+        vTaskDelay(pdMS_TO_TICKS(3));
+        return;
     }
 
-    vTaskDelay(pdMS_TO_TICKS(3));
+    uint32_t handler_start = micros();
+    uint32_t next_timer_ms = lv_timer_handler();
+    profilerNoteLoop(micros() - handler_start);
+    processUpdates();
+    checkAutoDim();
+    checkWiFiReconnect();
+    logHeapStatus();  // Periodic memory monitoring
+    profilerPollSerial();  // "perf" dumps frame timings as CSV
+
+    // Sleep until the next LVGL deadline; touch, Sonos updates and animations wake early
+    governorSleep(next_timer_ms, micros() - pass_start);
 }
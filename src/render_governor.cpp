@@ -0,0 +1,125 @@
+/**
+ * Render Governor
+ * Mode only changes LVGL timer periods (display refresh, touch read); loop() then
+ * sleeps on a task notification until lv_timer_handler's next deadline.
+ */
+
+#include "render_governor.h"
+#include "ui_common.h"
+#include "config.h"
+#include <esp_timer.h>
+
+static const char* const mode_names[GOV_MODE_COUNT] = {"active", "idle", "dimmed"};
+
+static TaskHandle_t loop_task = nullptr;
+static volatile uint32_t last_activity_ms = 0;
+static GovernorMode mode = GOV_ACTIVE;
+static lv_timer_t* refr_timer = nullptr;
+static lv_timer_t* indev_timer = nullptr;
+
+// Per-mode accounting since the last governorLogStats()
+struct ModeStats {
+    uint64_t time_us;
+    uint64_t busy_us;
+    uint32_t wakeups;
+};
+static ModeStats mode_stats[GOV_MODE_COUNT];
+static uint32_t last_mark_us = 0;
+static uint16_t wake_anims = 0;   // Running animations started with governorAnimStart()
+
+void governorInit() {
+    loop_task = xTaskGetCurrentTaskHandle();
+    lv_display_t* disp = lv_display_get_default();
+    if (disp) refr_timer = lv_display_get_refr_timer(disp);
+    lv_indev_t* indev = lv_indev_get_next(NULL);
+    if (indev) indev_timer = lv_indev_get_read_timer(indev);
+    last_activity_ms = millis();
+    last_mark_us = (uint32_t)esp_timer_get_time();
+}
+
+void governorWake() {
+    if (loop_task) xTaskNotifyGive(loop_task);
+}
+
+void governorActivity() {
+    last_activity_ms = millis();
+    governorWake();
+}
+
+// Also runs when lv_anim_start() replaces the animation or its object is deleted
+static void wake_anim_deleted_cb(lv_anim_t* a) {
+    if (wake_anims > 0) wake_anims--;
+}
+
+void governorAnimStart(lv_anim_t* a) {
+    lv_anim_set_deleted_cb(a, wake_anim_deleted_cb);
+    wake_anims++;
+    lv_anim_start(a);
+    governorActivity();
+}
+
+static void applyMode(GovernorMode m) {
+    if (m == mode) return;
+    mode = m;
+    uint32_t refr_ms = LV_DEF_REFR_PERIOD;
+    uint32_t indev_ms = LV_INDEV_DEF_READ_PERIOD;
+    if (m == GOV_IDLE) {
+        refr_ms = GOVERNOR_REFR_IDLE_MS;
+    } else if (m == GOV_DIMMED) {
+        refr_ms = GOVERNOR_REFR_DIMMED_MS;
+        indev_ms = GOVERNOR_INDEV_DIMMED_MS;
+    }
+    if (refr_timer) {
+        lv_timer_set_period(refr_timer, refr_ms);
+        if (m == GOV_ACTIVE) lv_timer_ready(refr_timer);  // Draw pending changes now, not at the old deadline
+    }
+    if (indev_timer) lv_timer_set_period(indev_timer, indev_ms);
+    DEBUG_VERBOSE("[GOV] Mode -> %s\n", mode_names[m]);
+}
+
+void governorSleep(uint32_t next_timer_ms, uint32_t busy_us) {
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    ModeStats* st = &mode_stats[mode];
+    st->time_us += now_us - last_mark_us;
+    st->busy_us += busy_us;
+    st->wakeups++;
+    last_mark_us = now_us;
+
+    // Only marked animations count - endless label scrolls must not hold full rate
+    if (wake_anims > 0) last_activity_ms = millis();
+
+    GovernorMode next = GOV_ACTIVE;
+    if (millis() - last_activity_ms > GOVERNOR_IDLE_AFTER_MS) {
+        next = screen_dimmed ? GOV_DIMMED : GOV_IDLE;
+    }
+    applyMode(next);
+
+    // Sleep until the next LVGL deadline (LV_NO_TIMER_READY = none), a wake, or the housekeeping bound
+    uint32_t wait_ms = next_timer_ms;
+    if (wait_ms > GOVERNOR_MAX_SLEEP_MS) wait_ms = GOVERNOR_MAX_SLEEP_MS;
+    TickType_t ticks = pdMS_TO_TICKS(wait_ms);
+    if (ticks == 0) ticks = 1;  // Always let the idle task run
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+GovernorMode governorMode() {
+    return mode;
+}
+
+void governorLogStats() {
+    uint64_t total_us = 0;
+    for (int i = 0; i < GOV_MODE_COUNT; i++) total_us += mode_stats[i].time_us;
+    if (total_us == 0) return;
+
+    Serial.print("[GOV]");
+    for (int i = 0; i < GOV_MODE_COUNT; i++) {
+        const ModeStats* st = &mode_stats[i];
+        if (st->time_us == 0) continue;
+        Serial.printf(" %s %lu%% (cpu %lu%%, %lu wake/s)", mode_names[i],
+                      (unsigned long)(st->time_us * 100 / total_us),
+                      (unsigned long)(st->busy_us * 100 / st->time_us),
+                      (unsigned long)((uint64_t)st->wakeups * 1000000 / st->time_us));
+    }
+    Serial.println();
+    memset(mode_stats, 0, sizeof(mode_stats));
+}
@@ -0,0 +1,579 @@
+/**
+ * Sonos ContentDirectory Browsing
+ * Folders are fetched in pages of BROWSE_PAGE_SIZE items by the network task
+ * (CMD_BROWSE) and cached per ObjectID + StartingIndex, so the UI never waits on a
+ * SOAP round-trip. A cached page older than BROWSE_REVALIDATE_MS is still shown and
+ * re-checked in the background: a changed folder UpdateID drops its pages.
+ *
+ * Each page is indexed once on fetch: the DIDL elements and every string a row or a
+ * tap needs (title, id, URI, play metadata) go into one PSRAM arena, so neither
+ * binding a row nor handling a tap parses XML.
+ *
+ * Large folders also get an A-Z jump index: titles sampled at most a page apart,
+ * which is enough to land within one page of any letter when the folder is sorted.
+ */
+
+#include "sonos_controller.h"
+#include "ui_common.h"
+#include "render_governor.h"
+
+// ============================================================================
+// Cache (deviceMutex held)
+// ============================================================================
+BrowsePage* SonosController::findBrowseSlot(const char* objectID, int start) {
+    for (int i = 0; i < BROWSE_CACHE_PAGES; i++) {
+        BrowsePage* pg = &browsePages[i];
+        if (pg->start == start && pg->objectID[0] && strcmp(pg->objectID, objectID) == 0) return pg;
+    }
+    return nullptr;
+}
+
+// The same page, a free slot, or the least recently used one
+BrowsePage* SonosController::allocBrowseSlot(const char* objectID, int start) {
+    BrowsePage* victim = &browsePages[0];
+    for (int i = 0; i < BROWSE_CACHE_PAGES; i++) {
+        BrowsePage* pg = &browsePages[i];
+        if (!pg->objectID[0] || (pg->start == start && strcmp(pg->objectID, objectID) == 0)) return pg;
+        if (pg->lastUse < victim->lastUse) victim = pg;
+    }
+    return victim;
+}
+
+static void freeBrowsePage(BrowsePage* pg) {
+    pg->objectID[0] = '\0';
+    if (pg->arena) heap_caps_free(pg->arena);
+    pg->arena = nullptr;
+    pg->arenaSize = 0;
+    pg->count = 0;
+}
+
+void SonosController::dropBrowseFolder(const char* objectID) {
+    for (int i = 0; i < BROWSE_CACHE_PAGES; i++) {
+        BrowsePage* pg = &browsePages[i];
+        if (pg->objectID[0] && strcmp(pg->objectID, objectID) == 0) freeBrowsePage(pg);
+    }
+}
+
+void SonosController::resetBrowseCache() {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    for (int i = 0; i < BROWSE_CACHE_PAGES; i++) freeBrowsePage(&browsePages[i]);
+    memset(&browseJump, 0, sizeof(browseJump));
+    bumpBrowseVersion();
+    xSemaphoreGive(deviceMutex);
+}
+
+// ============================================================================
+// Page index (network task)
+// ============================================================================
+struct BrowseArena {
+    char* buf;
+    uint32_t size;
+    uint32_t used;
+    uint32_t dropped;    // Strings that didn't fit (stored as "")
+};
+
+static uint32_t arenaPut(BrowseArena* a, const char* s, size_t len) {
+    if (len == 0) return 0;
+    if (a->used + len + 1 > a->size) {
+        a->dropped++;
+        return 0;
+    }
+    uint32_t off = a->used;
+    memcpy(a->buf + off, s, len);
+    a->buf[off + len] = '\0';
+    a->used += len + 1;
+    return off;
+}
+
+static uint32_t arenaPut(BrowseArena* a, const String& s) {
+    return arenaPut(a, s.c_str(), s.length());
+}
+
+// Value of the first attr="..." in [from, limit)
+static String attrValue(const String& xml, int from, int limit, const char* attr) {
+    char key[24];
+    snprintf(key, sizeof(key), " %s=\"", attr);
+    int p = xml.indexOf(key, from);
+    if (p < 0 || p >= limit) return "";
+    p += strlen(key);
+    int q = xml.indexOf('"', p);
+    if (q < 0 || q > limit) return "";
+    return xml.substring(p, q);
+}
+
+// Art URI of [start, end), made absolute against the player for /getaa paths
+static uint32_t putArtURL(SonosController* c, BrowseArena* a, const String& xml, int start, int end, const char* host) {
+    String art = c->decodeHTML(c->extractXMLRange(xml, "upnp:albumArtURI", start, end));
+    if (art.startsWith("/")) art = "http://" + String(host) + ":1400" + art;
+    return arenaPut(a, art);
+}
+
+// Walk the page's <container>/<item> elements once; returns the rows indexed
+static int buildBrowseIndex(SonosController* c, const String& didl, const char* host, BrowseArena* a,
+                            BrowseRow* rows) {
+    int count = 0;
+    int pos = 0;
+    while (count < BROWSE_PAGE_SIZE) {
+        int containerPos = didl.indexOf("<container", pos);
+        int itemPos = didl.indexOf("<item", pos);
+        if (containerPos < 0 && itemPos < 0) break;
+        bool container = containerPos >= 0 && (itemPos < 0 || containerPos < itemPos);
+        int start = container ? containerPos : itemPos;
+        int end = didl.indexOf(container ? "</container>" : "</item>", start);
+        if (end < 0) break;
+        end += container ? 12 : 7;
+        pos = end;
+
+        BrowseRow* r = &rows[count++];
+        memset(r, 0, sizeof(*r));
+        r->container = container;
+        r->item = arenaPut(a, didl.c_str() + start, end - start);
+        String id = attrValue(didl, start, end, "id");
+        String title = c->decodeHTML(c->extractXMLRange(didl, "dc:title", start, end));
+        r->art = putArtURL(c, a, didl, start, end, host);
+
+        if (container) {
+            r->action = (id.startsWith("SQ:") && id.indexOf('/') < 0) ? BROWSE_PLAY_PLAYLIST : BROWSE_OPEN;
+            r->id = arenaPut(a, id);
+            r->title = arenaPut(a, title);
+            continue;
+        }
+
+        String uri = c->decodeHTML(c->extractXMLRange(didl, "res", start, end));
+        String resMD = c->extractXMLRange(didl, "r:resMD", start, end);
+        if (resMD.length() > 0) resMD = c->decodeHTML(resMD);
+
+        if (uri.length() == 0 && resMD.length() > 0) {
+            if (resMD.indexOf("<upnp:class>object.container</upnp:class>") >= 0) {
+                // Shortcut to a container (e.g. a favorite album) - opens as a folder
+                r->action = BROWSE_OPEN;
+                r->id = arenaPut(a, attrValue(resMD, 0, resMD.length(), "id"));
+                r->title = arenaPut(a, c->extractXML(resMD, "dc:title"));
+                continue;
+            }
+            uri = c->extractXML(resMD, "res");
+        }
+
+        r->id = arenaPut(a, id);
+        r->title = arenaPut(a, title);
+        r->uri = arenaPut(a, uri);
+        r->meta = r->item;
+        if (uri.startsWith("x-rincon-cpcontainer:")) {
+            r->action = BROWSE_PLAY_CONTAINER;
+            if (resMD.length() > 0) {
+                // Inner DIDL needs the outer <res> (injected after <upnp:class>)
+                String resElement = "<res protocolInfo=\"" + attrValue(didl, start, end, "protocolInfo") + "\">" +
+                                    uri + "</res>";
+                int insertPos = resMD.indexOf("</upnp:class>") + 13;
+                if (insertPos > 13) resMD = resMD.substring(0, insertPos) + resElement + resMD.substring(insertPos);
+                r->meta = arenaPut(a, resMD);
+            }
+        } else if (uri.length() > 0) {
+            r->action = BROWSE_PLAY_URI;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// Network task side
+// ============================================================================
+bool SonosController::fetchBrowsePage(const char* objectID, int start) {
+    static char args[512];  // Network task only
+    snprintf(args, sizeof(args),
+        "<ObjectID>%s</ObjectID>"
+        "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
+        "<Filter>*</Filter>"
+        "<StartingIndex>%d</StartingIndex>"
+        "<RequestedCount>%d</RequestedCount>"
+        "<SortCriteria></SortCriteria>",
+        objectID, start, BROWSE_PAGE_SIZE);
+
+    uint32_t t0 = millis();
+    String resp = sendSOAP("ContentDirectory", "Browse", args);
+    if (resp.length() == 0) {
+        Serial.printf("[BROWSE] %s @%d failed\n", objectID, start);
+        return false;
+    }
+    int total = extractXML(resp, "TotalMatches").toInt();
+    uint32_t updateID = (uint32_t)extractXML(resp, "UpdateID").toInt();
+    String didl = decodeHTMLEntities(extractXML(resp, "Result"));
+    resp = String();  // Free the raw response before indexing
+
+    // Index into a worst-case arena (element copies + decoded strings), then shrink it
+    static BrowseRow stageRows[BROWSE_PAGE_SIZE];  // Network task only
+    BrowseArena arena = {};
+    arena.size = didl.length() * 2 + 256 * BROWSE_PAGE_SIZE + 1;
+    arena.buf = (char*)heap_caps_malloc(arena.size, MALLOC_CAP_SPIRAM);
+    if (!arena.buf) {
+        Serial.printf("[BROWSE] ERROR: No memory for %lu byte page arena\n", (unsigned long)arena.size);
+        return false;
+    }
+    arena.buf[0] = '\0';
+    arena.used = 1;
+    SonosDevice* dev = getCurrentDevice();
+    char host[16];
+    strlcpy(host, dev ? dev->ip.toString().c_str() : "", sizeof(host));
+    int count = buildBrowseIndex(this, didl, host, &arena, stageRows);
+    uint32_t didlBytes = didl.length();
+    didl = String();
+    char* shrunk = (char*)heap_caps_realloc(arena.buf, arena.used, MALLOC_CAP_SPIRAM);
+    if (shrunk) arena.buf = shrunk;
+    if (arena.dropped) Serial.printf("[BROWSE] WARNING: %lu strings didn't fit the page arena\n", (unsigned long)arena.dropped);
+
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(500))) {
+        heap_caps_free(arena.buf);
+        return false;
+    }
+    // Pages fetched under another UpdateID are from before a change to the folder
+    for (int i = 0; i < BROWSE_CACHE_PAGES; i++) {
+        BrowsePage* pg = &browsePages[i];
+        if (pg->objectID[0] && pg->updateID != updateID && strcmp(pg->objectID, objectID) == 0) {
+            dropBrowseFolder(objectID);
+            break;
+        }
+    }
+    BrowsePage* pg = allocBrowseSlot(objectID, start);
+    freeBrowsePage(pg);
+    strlcpy(pg->objectID, objectID, sizeof(pg->objectID));
+    pg->start = start;
+    pg->count = count;
+    pg->total = total;
+    pg->updateID = updateID;
+    pg->checkedAt = millis();
+    pg->lastUse = pg->checkedAt;
+    pg->arena = arena.buf;
+    pg->arenaSize = arena.used;
+    memcpy(pg->rows, stageRows, sizeof(BrowseRow) * count);
+    bumpBrowseVersion();
+    xSemaphoreGive(deviceMutex);
+
+    Serial.printf("[BROWSE] %s @%d: %d of %d items, DIDL %lu -> arena %lu bytes, %lu ms\n", objectID, start,
+                  count, total, (unsigned long)didlBytes, (unsigned long)arena.used, (unsigned long)(millis() - t0));
+    return true;
+}
+
+void SonosController::processBrowse(int slot) {
+    if (slot < 0 || slot >= BROWSE_REQ_SLOTS) return;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    BrowseRequest req = browseRequests[slot];
+    bool superseded = req.foreground && req.ticket != browseForeground;
+    BrowsePage* cached = findBrowseSlot(req.objectID, req.start);
+    uint32_t cachedID = cached ? cached->updateID : 0;
+    xSemaphoreGive(deviceMutex);
+
+    bool ok = true;
+    if (!req.pending || superseded) {
+        // The user navigated on (or a later post already handled this slot)
+    } else if (cached && !req.revalidate) {
+        // Fetched meanwhile (e.g. prefetch, then opened)
+    } else if (cached) {
+        uint32_t id;
+        if (probeContainer(req.objectID, &id, nullptr) && id == cachedID) {
+            if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+                for (int i = 0; i < BROWSE_CACHE_PAGES; i++) {
+                    BrowsePage* pg = &browsePages[i];
+                    if (pg->objectID[0] && strcmp(pg->objectID, req.objectID) == 0) pg->checkedAt = millis();
+                }
+                xSemaphoreGive(deviceMutex);
+            }
+        } else {
+            Serial.printf("[BROWSE] %s changed - refetching\n", req.objectID);
+            if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+                dropBrowseFolder(req.objectID);
+                bumpBrowseVersion();
+                xSemaphoreGive(deviceMutex);
+            }
+            ok = fetchBrowsePage(req.objectID, req.start);
+        }
+    } else {
+        ok = fetchBrowsePage(req.objectID, req.start);
+    }
+
+    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+        if (browseRequests[slot].ticket == req.ticket) browseRequests[slot].pending = false;
+        xSemaphoreGive(deviceMutex);
+    }
+    if (!ok && req.foreground) {
+        __atomic_store_n(&browseFailTicket, req.ticket, __ATOMIC_RELAXED);  // Published by the bump
+        bumpBrowseVersion();
+    }
+    governorWake();
+}
+
+// ============================================================================
+// Jump index (network task)
+// ============================================================================
+char browseSortKey(const char* title) {
+    char c = title ? title[0] : '\0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 'A';
+    if (c >= 'A' && c <= 'Z') return c;
+    return '#';  // Digits, symbols, non-ASCII
+}
+
+// Sort key of one item: from a cached page, else a single-item title-only browse
+bool SonosController::fetchBrowseKey(const char* objectID, int index, uint32_t updateID, char* key) {
+    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+        BrowsePage* pg = findBrowseSlot(objectID, index - index % BROWSE_PAGE_SIZE);
+        bool hit = pg && pg->updateID == updateID && index - pg->start < pg->count;
+        if (hit) *key = browseSortKey(pg->str(pg->rows[index - pg->start].title));
+        xSemaphoreGive(deviceMutex);
+        if (hit) return true;
+    }
+
+    static char args[384];  // Network task only
+    snprintf(args, sizeof(args),
+        "<ObjectID>%s</ObjectID>"
+        "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
+        "<Filter>dc:title</Filter>"
+        "<StartingIndex>%d</StartingIndex>"
+        "<RequestedCount>1</RequestedCount>"
+        "<SortCriteria></SortCriteria>",
+        objectID, index);
+    String resp = sendSOAP("ContentDirectory", "Browse", args);
+    if (resp.length() == 0) return false;
+    if ((uint32_t)extractXML(resp, "UpdateID").toInt() != updateID) return false;  // Folder changed
+    String didl = decodeHTMLEntities(extractXML(resp, "Result"));
+    *key = browseSortKey(decodeHTML(extractXML(didl, "dc:title")).c_str());
+    return true;
+}
+
+void SonosController::buildBrowseJump() {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    static BrowseJumpIndex job;  // Network task only
+    job = browseJump;
+    xSemaphoreGive(deviceMutex);
+    if (job.ready || !job.objectID[0] || job.total < 2) return;
+
+    // Samples at most a page apart, first and last item included
+    int samples = (job.total - 2) / BROWSE_PAGE_SIZE + 2;
+    if (samples > BROWSE_JUMP_SAMPLES) samples = BROWSE_JUMP_SAMPLES;
+    uint32_t t0 = millis();
+    for (int k = 0; k < samples; k++) {
+        int index = (int)((int64_t)k * (job.total - 1) / (samples - 1));
+        if (!fetchBrowseKey(job.objectID, index, job.updateID, &job.key[k])) {
+            Serial.printf("[BROWSE] Jump index for %s abandoned at sample %d\n", job.objectID, k);
+            return;
+        }
+        job.index[k] = index;
+        // Stop early once the user has left the folder
+        if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+        bool wanted = strcmp(browseJump.objectID, job.objectID) == 0 && browseJump.updateID == job.updateID;
+        xSemaphoreGive(deviceMutex);
+        if (!wanted) return;
+    }
+    job.count = samples;
+
+    // '#' after a letter is an accented or symbol title sorted in place - not a break
+    job.sorted = true;
+    char last = '\0';
+    for (int k = 0; k < samples; k++) {
+        char c = job.key[k];
+        if (c == '#' && last >= 'A') continue;
+        if (c < last) job.sorted = false;
+        last = c;
+    }
+    job.ready = true;
+
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    if (strcmp(browseJump.objectID, job.objectID) == 0 && browseJump.updateID == job.updateID) {
+        browseJump = job;
+        bumpBrowseVersion();
+    }
+    xSemaphoreGive(deviceMutex);
+    Serial.printf("[BROWSE] Jump index for %s: %d samples of %d items (%s), %lu ms\n", job.objectID, samples,
+                  job.total, job.sorted ? "sorted" : "unsorted - hidden", (unsigned long)(millis() - t0));
+    governorWake();
+}
+
+// ============================================================================
+// UI side
+// ============================================================================
+uint32_t SonosController::requestBrowse(const char* objectID, int start, bool foreground) {
+    if (!objectID || !objectID[0]) return 0;
+    start -= start % BROWSE_PAGE_SIZE;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20))) return 0;  // Caller retries while the page is missing
+
+    BrowsePage* pg = findBrowseSlot(objectID, start);
+    bool revalidate = false;
+    if (pg) {
+        pg->lastUse = millis();
+        if (millis() - pg->checkedAt < BROWSE_REVALIDATE_MS) {
+            xSemaphoreGive(deviceMutex);
+            return 0;
+        }
+        revalidate = true;
+        pg->checkedAt = millis();  // One re-check per interval
+    }
+
+    // Already posted: share the ticket (a foreground open takes over a prefetch)
+    for (int i = 0; i < BROWSE_REQ_SLOTS; i++) {
+        BrowseRequest* req = &browseRequests[i];
+        if (!req->pending || req->start != start || strcmp(req->objectID, objectID) != 0) continue;
+        if (foreground) {
+            req->foreground = true;
+            browseForeground = req->ticket;
+        }
+        uint32_t ticket = req->ticket;
+        xSemaphoreGive(deviceMutex);
+        return ticket;
+    }
+
+    int slot = browseReqHead++ % BROWSE_REQ_SLOTS;
+    BrowseRequest* req = &browseRequests[slot];
+    strlcpy(req->objectID, objectID, sizeof(req->objectID));
+    req->start = start;
+    req->ticket = ++browseTicket;
+    req->foreground = foreground;
+    req->revalidate = revalidate;
+    req->pending = true;
+    if (foreground) browseForeground = req->ticket;
+    uint32_t ticket = req->ticket;
+    xSemaphoreGive(deviceMutex);
+
+    CommandRequest_t cmd = { CMD_BROWSE, slot };
+    if (xQueueSend(commandQueue, &cmd, 0) != pdTRUE) {
+        if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20))) {
+            req->pending = false;
+            xSemaphoreGive(deviceMutex);
+        }
+        if (foreground) __atomic_store_n(&browseFailTicket, ticket, __ATOMIC_RELAXED);
+        bumpBrowseVersion();
+    }
+    return ticket;
+}
+
+void SonosController::injectBrowsePage(const char* objectID, int start, int count, int total,
+                                       bool (*fill)(int index, char* title, size_t len)) {
+    if (count > BROWSE_PAGE_SIZE) count = BROWSE_PAGE_SIZE;
+    BrowseArena arena = {};
+    arena.size = (uint32_t)count * SNAP_TEXT_LEN + 1;
+    arena.buf = (char*)heap_caps_malloc(arena.size, MALLOC_CAP_SPIRAM);
+    if (!arena.buf) return;
+    arena.buf[0] = '\0';
+    arena.used = 1;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+        heap_caps_free(arena.buf);
+        return;
+    }
+    BrowsePage* pg = allocBrowseSlot(objectID, start);
+    freeBrowsePage(pg);
+    strlcpy(pg->objectID, objectID, sizeof(pg->objectID));
+    pg->start = start;
+    pg->count = count;
+    pg->total = total;
+    pg->updateID = 0;
+    pg->checkedAt = millis();  // Fresh - opening the folder posts no request
+    pg->lastUse = pg->checkedAt;
+    static char title[SNAP_TEXT_LEN];  // Guarded by deviceMutex
+    for (int i = 0; i < count; i++) {
+        BrowseRow* r = &pg->rows[i];
+        memset(r, 0, sizeof(*r));
+        title[0] = '\0';
+        r->container = fill(start + i, title, sizeof(title));
+        r->action = r->container ? BROWSE_OPEN : BROWSE_NONE;
+        r->title = arenaPut(&arena, title, strlen(title));
+    }
+    pg->arena = arena.buf;
+    pg->arenaSize = arena.used;
+    bumpBrowseVersion();
+    xSemaphoreGive(deviceMutex);
+}
+
+bool SonosController::lockBrowse() {
+    return xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20)) == pdTRUE;
+}
+
+void SonosController::unlockBrowse() {
+    xSemaphoreGive(deviceMutex);
+}
+
+const BrowsePage* SonosController::getBrowsePage(const char* objectID, int index) {
+    if (index < 0) return nullptr;
+    BrowsePage* pg = findBrowseSlot(objectID, index - index % BROWSE_PAGE_SIZE);
+    if (pg) pg->lastUse = millis();
+    return pg;
+}
+
+void SonosController::requestBrowseJump(const char* objectID, int total, uint32_t updateID) {
+    if (!objectID || !objectID[0] || total < BROWSE_JUMP_MIN_ITEMS) return;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20))) return;
+    bool same = strcmp(browseJump.objectID, objectID) == 0 && browseJump.updateID == updateID;
+    if (!same) {
+        memset(&browseJump, 0, sizeof(browseJump));
+        strlcpy(browseJump.objectID, objectID, sizeof(browseJump.objectID));
+        browseJump.updateID = updateID;
+        browseJump.total = total;
+    }
+    xSemaphoreGive(deviceMutex);
+    if (same) return;  // Built or being built
+
+    CommandRequest_t cmd = { CMD_BROWSE_JUMP, 0 };
+    if (xQueueSend(commandQueue, &cmd, 0) != pdTRUE && xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20))) {
+        browseJump.objectID[0] = '\0';  // Let the next request retry
+        xSemaphoreGive(deviceMutex);
+    }
+}
+
+bool SonosController::getBrowseJump(const char* objectID, uint32_t updateID, BrowseJumpIndex* out) {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(20))) return false;
+    bool ok = browseJump.ready && browseJump.updateID == updateID && strcmp(browseJump.objectID, objectID) == 0;
+    if (ok) *out = browseJump;
+    xSemaphoreGive(deviceMutex);
+    return ok;
+}
+
+// ============================================================================
+// Playlist lookup (saveCurrentTrack)
+// ============================================================================
+// Sonos playlist ID for a title: cached SQ: pages first (Sources screen / quick-launch
+// grid keep page 0 warm), otherwise title-only pages of SQ: until it turns up
+bool SonosController::findPlaylistID(const char* title, char* id, size_t len) {
+    id[0] = '\0';
+    int total = -1;
+    if (lockBrowse()) {
+        for (int index = 0; !id[0];) {
+            const BrowsePage* pg = getBrowsePage("SQ:", index);
+            if (!pg) break;
+            for (int i = 0; i < pg->count && !id[0]; i++) {
+                if (strcmp(pg->str(pg->rows[i].title), title) == 0) strlcpy(id, pg->str(pg->rows[i].id), len);
+            }
+            total = pg->total;
+            index = pg->start + pg->count;
+            if (pg->count == 0 || index >= total) break;
+        }
+        unlockBrowse();
+    }
+    if (id[0]) return true;
+    if (total >= 0 && total <= BROWSE_PAGE_SIZE) return false;  // Whole folder was cached
+
+    char args[320];
+    for (int start = 0; !id[0];) {
+        snprintf(args, sizeof(args),
+            "<ObjectID>SQ:</ObjectID>"
+            "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
+            "<Filter>dc:title</Filter>"
+            "<StartingIndex>%d</StartingIndex>"
+            "<RequestedCount>%d</RequestedCount>"
+            "<SortCriteria></SortCriteria>", start, BROWSE_PAGE_SIZE);
+        String resp = sendSOAP("ContentDirectory", "Browse", args);
+        int returned = extractXML(resp, "NumberReturned").toInt();
+        total = extractXML(resp, "TotalMatches").toInt();
+        String didl = decodeHTMLEntities(extractXML(resp, "Result"));
+        resp = String();
+
+        int pos = 0;
+        while ((pos = didl.indexOf("<container", pos)) >= 0) {
+            int end = didl.indexOf("</container>", pos);
+            if (end < 0) break;
+            if (decodeHTML(extractXMLRange(didl, "dc:title", pos, end)) == title) {
+                strlcpy(id, attrValue(didl, pos, end, "id").c_str(), len);
+                break;
+            }
+            pos = end;
+        }
+        start += returned;
+        if (returned <= 0 || start >= total) break;
+    }
+    return id[0] != '\0';
+}
@@ -8,6 +8,7 @@
 #include <HTTPClient.h>
 #include "lvgl.h"
 #include "ui_common.h"
+#include "render_governor.h"
 
 // Command debounce tracking
 static uint32_t lastCommandTime = 0;
@@ -25,9 +26,46 @@ SonosController::SonosController() {
     currentDeviceIndex = -1;
     deviceMutex = NULL;
     commandQueue = NULL;
-    uiUpdateQueue = NULL;
     networkTaskHandle = NULL;
     pollingTaskHandle = NULL;
+    memset(&snapshot, 0, sizeof(snapshot));
+    memset(&snapshotStage, 0, sizeof(snapshotStage));
+    snapshotSeq = 0;
+    queueVersion = 0;
+    uiRingHead = 0;
+    uiRingTail = 0;
+    uiRingOverflow = 0;
+    for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+        queuePages[i].start = -1;
+        queuePages[i].arena = nullptr;
+    }
+    queueStage.start = -1;
+    queueStage.arena = nullptr;
+    queueGeneration = 0;
+    queueViewIndex = -1;
+    queuePagePending = 0;
+    queueUpdateID = 0;
+    queueUpdateIDValid = false;
+    queueUnprobedMs = 0;
+    queueDirtyFirst = -1;
+    queueDirtyLast = -1;
+    queueEditHead = 0;
+    queueEditTail = 0;
+    queueEditSeq = 0;
+    queueEditBusy = false;
+    queueEditDropPending = false;
+    memset(browsePages, 0, sizeof(browsePages));
+    memset(&browseJump, 0, sizeof(browseJump));
+    savePlaylistName[0] = '\0';
+    savePlaylistID[0] = '\0';
+    savePlaylistUpdateID = 0;
+    savePlaylistUpdateIDValid = false;
+    memset(browseRequests, 0, sizeof(browseRequests));
+    browseReqHead = 0;
+    browseTicket = 0;
+    browseForeground = 0;
+    browseFailTicket = 0;
+    browseVersion = 0;
 }
 
 SonosController::~SonosController() {
@@ -35,14 +73,22 @@ SonosController::~SonosController() {
     if (pollingTaskHandle) vTaskDelete(pollingTaskHandle);
     if (deviceMutex) vSemaphoreDelete(deviceMutex);
     if (commandQueue) vQueueDelete(commandQueue);
-    if (uiUpdateQueue) vQueueDelete(uiUpdateQueue);
 }
 
 void SonosController::begin() {
     deviceMutex = xSemaphoreCreateMutex();
     commandQueue = xQueueCreate(SONOS_CMD_QUEUE_SIZE, sizeof(CommandRequest_t));
-    uiUpdateQueue = xQueueCreate(SONOS_UI_QUEUE_SIZE, sizeof(UIUpdate_t));
     prefs.begin("sonos", false);
+
+    // Queue page arenas (+ the parse stage) in one PSRAM block
+    size_t arenaBytes = (size_t)(SONOS_QUEUE_PAGE_SLOTS + 1) * SONOS_QUEUE_ARENA_SIZE;
+    char* arenas = (char*)heap_caps_malloc(arenaBytes, MALLOC_CAP_SPIRAM);
+    if (arenas) {
+        for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) queuePages[i].arena = arenas + (size_t)i * SONOS_QUEUE_ARENA_SIZE;
+        queueStage.arena = arenas + (size_t)SONOS_QUEUE_PAGE_SLOTS * SONOS_QUEUE_ARENA_SIZE;
+    } else {
+        Serial.println("[SONOS] ERROR: Failed to allocate queue arenas!");
+    }
     Serial.println("[SONOS] SonosController initialized");
 }
 
@@ -79,6 +125,10 @@ SonosDevice* SonosController::getCurrentDevice() {
 
 void SonosController::selectDevice(int index) {
     if (index >= 0 && index < deviceCount) {
+        if (index != currentDeviceIndex) {
+            resetQueuePages();  // Pages belong to the old speaker
+            resetBrowseCache();
+        }
         currentDeviceIndex = index;
         devices[index].connected = true;
         Serial.printf("[SONOS] Selected: %s\n", devices[index].ip.toString().c_str());
@@ -119,10 +169,10 @@ String SonosController::sendSOAP(const char* service, const char* action, const
     snprintf(url, sizeof(url), "http://%s:1400%s", dev->ip.toString().c_str(), endpoint);
 
     // Validate args size to prevent buffer overflow
-    // SOAP wrapper adds ~400 bytes, so args must stay under 1600 bytes
+    // SOAP wrapper adds ~400 bytes, so args must stay under SONOS_SOAP_ARGS_MAX
     size_t args_len = strlen(args);
-    if (args_len > 1600) {
-        Serial.printf("[SONOS] ERROR: SOAP args too large (%d bytes, max 1600)\n", args_len);
+    if (args_len > SONOS_SOAP_ARGS_MAX) {
+        Serial.printf("[SONOS] ERROR: SOAP args too large (%d bytes, max %d)\n", args_len, SONOS_SOAP_ARGS_MAX);
         return "";
     }
 
@@ -167,6 +217,7 @@ String SonosController::sendSOAP(const char* service, const char* action, const
         return "";
     }
 
+    bool was_connected = dev->connected;
     int code = http.POST(body);
     String response = "";  // Keep String for return value (used by callers)
 
@@ -219,6 +270,9 @@ String SonosController::sendSOAP(const char* service, const char* action, const
     // Release network mutex after HTTP operation completes
     xSemaphoreGive(network_mutex);
 
+    // Polls only notify on success - a lost connection has to be pushed from here
+    if (dev->connected != was_connected) notifyUI(UPDATE_ERROR);
+
     return response;
 }
 
@@ -412,6 +466,14 @@ void SonosController::playQueueItem(int index) {
     xQueueSend(commandQueue, &cmd, 0);
 }
 
+void SonosController::requestQueueRefresh() {
+    CommandRequest_t cmd = { CMD_REFRESH_QUEUE, 0 };
+    xQueueSend(commandQueue, &cmd, 0);
+}
+
+// Two small round-trips in the steady state: the current item's own DIDL (Q:0/<n>) and
+// the add. The playlist ID is resolved once and its UpdateID carried over from each
+// add's NewUpdateID; a stale UpdateID costs one metadata probe and a retry.
 bool SonosController::saveCurrentTrack(const char* playlistName) {
     SonosDevice* dev = getCurrentDevice();
     if (!dev || !dev->connected) {
@@ -428,147 +490,103 @@ bool SonosController::saveCurrentTrack(const char* playlistName) {
         return false;
     }
 
-    Serial.printf("[FAV] Current track number in queue: %d\n", currentTrackNum);
-
-    // Browse the queue to get the current track WITH metadata
-    String browseQueue = sendSOAP("ContentDirectory", "Browse",
-        "<ObjectID>Q:0</ObjectID>"
-        "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
-        "<Filter>*</Filter>"
+    // Queue items are Q:0/<n> (1-based) - browse just that one, and only the fields a
+    // saved queue entry needs: the metadata is sent on still entity-encoded, so it has
+    // to stay well under SONOS_SOAP_ARGS_MAX
+    char args[320];
+    snprintf(args, sizeof(args),
+        "<ObjectID>Q:0/%d</ObjectID>"
+        "<BrowseFlag>BrowseMetadata</BrowseFlag>"
+        "<Filter>dc:title,dc:creator,upnp:album,upnp:albumArtURI,upnp:class,res</Filter>"
         "<StartingIndex>0</StartingIndex>"
-        "<RequestedCount>1000</RequestedCount>"
-        "<SortCriteria></SortCriteria>");
-
-    // Extract DIDL from Result
-    String queueDIDL = extractXML(browseQueue, "Result");
-
-    // Decode HTML entities
-    queueDIDL = decodeHTMLEntities(queueDIDL);
-
-    // Find the item for current track number
-    String trackMetadata = "";
-    String trackURI = "";
-
-    int pos = 0;
-    int itemCount = 0;
-    while ((pos = queueDIDL.indexOf("<item", pos)) >= 0) {
-        itemCount++;
-
-        if (itemCount == currentTrackNum) {
-            int endPos = queueDIDL.indexOf("</item>", pos) + 7;
-            String itemXML = queueDIDL.substring(pos, endPos);
-
-            // Extract URI before encoding
-            int resStart = itemXML.indexOf("<res");
-            if (resStart >= 0) {
-                int resEnd = itemXML.indexOf("</res>", resStart);
-                int resContentStart = itemXML.indexOf(">", resStart) + 1;
-                trackURI = itemXML.substring(resContentStart, resEnd);
-            }
-
-            // Re-encode for SOAP
-            encodeXML(itemXML);
-
-            trackMetadata = itemXML;
-
-            Serial.printf("[FAV] Found track metadata, length: %d\n", trackMetadata.length());
-            Serial.printf("[FAV] Track URI: %s\n", trackURI.c_str());
-            break;
-        }
-
-        pos = queueDIDL.indexOf("</item>", pos) + 7;
-    }
+        "<RequestedCount>1</RequestedCount>"
+        "<SortCriteria></SortCriteria>", currentTrackNum);
+    String resp = sendSOAP("ContentDirectory", "Browse", args);
 
+    // Result is still entity-encoded - exactly what EnqueuedURIMetaData wants
+    String trackMetadata = extractXML(resp, "Result");
+    resp = String();
+    String trackURI = extractXML(decodeHTMLEntities(trackMetadata), "res");
     if (trackMetadata.length() == 0 || trackURI.length() == 0) {
-        Serial.println("[FAV] Could not find track in queue");
+        Serial.printf("[FAV] Could not read queue item %d\n", currentTrackNum);
         return false;
     }
+    Serial.printf("[FAV] Track %d: %s (metadata %d bytes)\n", currentTrackNum, trackURI.c_str(), trackMetadata.length());
+
+    // Resolve the playlist once per name
+    if (!savePlaylistID[0] || strcmp(savePlaylistName, playlistName) != 0) {
+        savePlaylistUpdateIDValid = false;
+        strlcpy(savePlaylistName, playlistName, sizeof(savePlaylistName));
+        if (findPlaylistID(playlistName, savePlaylistID, sizeof(savePlaylistID))) {
+            Serial.printf("[FAV] Found existing playlist: %s\n", savePlaylistID);
+        } else {
+            Serial.printf("[FAV] Creating playlist: %s\n", playlistName);
+
+            String title = playlistName;
+            encodeXML(title);
+            String createArgs = "<InstanceID>0</InstanceID>"
+                               "<Title>" + title + "</Title>"
+                               "<EnqueuedURI></EnqueuedURI>"
+                               "<EnqueuedURIMetaData></EnqueuedURIMetaData>";
+
+            String createResp = sendSOAP("AVTransport", "CreateSavedQueue", createArgs.c_str());
+            strlcpy(savePlaylistID, extractXML(createResp, "AssignedObjectID").c_str(), sizeof(savePlaylistID));
+            String newUpdateID = extractXML(createResp, "NewUpdateID");
+            if (newUpdateID.length() > 0) {
+                savePlaylistUpdateID = (uint32_t)newUpdateID.toInt();
+                savePlaylistUpdateIDValid = true;
+            }
 
-    // Check if playlist exists
-    String browseResp = sendSOAP("ContentDirectory", "Browse",
-        "<ObjectID>SQ:</ObjectID>"
-        "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
-        "<Filter>*</Filter>"
-        "<StartingIndex>0</StartingIndex>"
-        "<RequestedCount>100</RequestedCount>"
-        "<SortCriteria></SortCriteria>");
-
-    String didlContent = extractXML(browseResp, "Result");
-    didlContent = decodeHTMLEntities(didlContent);
-
-    String playlistID = "";
-    pos = 0;
-    while ((pos = didlContent.indexOf("<container", pos)) >= 0) {
-        int endPos = didlContent.indexOf("</container>", pos);
-        if (endPos < 0) break;
-
-        String container = didlContent.substring(pos, endPos);
-
-        int idStart = container.indexOf("id=\"") + 4;
-        int idEnd = container.indexOf("\"", idStart);
-        String id = container.substring(idStart, idEnd);
-
-        int titleStart = container.indexOf("<dc:title>") + 10;
-        int titleEnd = container.indexOf("</dc:title>", titleStart);
-        if (titleStart < 10 || titleEnd < 0) { pos = endPos; continue; }
-        String title = container.substring(titleStart, titleEnd);
-
-        if (title == playlistName) {
-            playlistID = id;
-            Serial.printf("[FAV] Found existing playlist: %s\n", playlistID.c_str());
-            break;
+            if (!savePlaylistID[0]) {
+                Serial.println("[FAV] Failed to create playlist");
+                return false;
+            }
+            if (lockBrowse()) {  // Cached playlist list lacks the new one
+                dropBrowseFolder("SQ:");
+                bumpBrowseVersion();
+                unlockBrowse();
+            }
         }
-
-        pos = endPos;
     }
 
-    // Create playlist if doesn't exist
-    if (playlistID.length() == 0) {
-        Serial.printf("[FAV] Creating playlist: %s\n", playlistName);
-
-        String createArgs = "<InstanceID>0</InstanceID>"
-                           "<Title>" + String(playlistName) + "</Title>"
-                           "<EnqueuedURI></EnqueuedURI>"
-                           "<EnqueuedURIMetaData></EnqueuedURIMetaData>";
-
-        String createResp = sendSOAP("AVTransport", "CreateSavedQueue", createArgs.c_str());
-        playlistID = extractXML(createResp, "AssignedObjectID");
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!savePlaylistUpdateIDValid) {
+            if (!probeContainer(savePlaylistID, &savePlaylistUpdateID, nullptr)) {
+                Serial.printf("[FAV] Playlist %s is gone\n", savePlaylistID);
+                savePlaylistID[0] = '\0';  // Resolve again next time
+                return false;
+            }
+            savePlaylistUpdateIDValid = true;
+        }
 
-        if (playlistID.length() == 0) {
-            Serial.println("[FAV] Failed to create playlist");
+        // Add track with proper metadata
+        String addArgs = "<InstanceID>0</InstanceID>"
+                        "<ObjectID>" + String(savePlaylistID) + "</ObjectID>"
+                        "<UpdateID>" + String(savePlaylistUpdateID) + "</UpdateID>"
+                        "<EnqueuedURI>" + trackURI + "</EnqueuedURI>"
+                        "<EnqueuedURIMetaData>" + trackMetadata + "</EnqueuedURIMetaData>"
+                        "<AddAtIndex>4294967295</AddAtIndex>";
+        if (addArgs.length() > SONOS_SOAP_ARGS_MAX) {
+            // sendSOAP would refuse it - not an UpdateID conflict, so don't retry
+            Serial.printf("[FAV] Track metadata too large to save (%d bytes of args, max %d)\n",
+                          addArgs.length(), SONOS_SOAP_ARGS_MAX);
             return false;
         }
-    }
-
-    // Get UpdateID
-    String browsePlaylist = sendSOAP("ContentDirectory", "Browse",
-        ("<ObjectID>" + playlistID + "</ObjectID>"
-        "<BrowseFlag>BrowseMetadata</BrowseFlag>"
-        "<Filter>*</Filter>"
-        "<StartingIndex>0</StartingIndex>"
-        "<RequestedCount>1</RequestedCount>"
-        "<SortCriteria></SortCriteria>").c_str());
-
-    String updateID = extractXML(browsePlaylist, "UpdateID");
-    if (updateID.length() == 0) updateID = "0";
-
-    // Add track with proper metadata
-    String addArgs = "<InstanceID>0</InstanceID>"
-                    "<ObjectID>" + playlistID + "</ObjectID>"
-                    "<UpdateID>" + updateID + "</UpdateID>"
-                    "<EnqueuedURI>" + trackURI + "</EnqueuedURI>"
-                    "<EnqueuedURIMetaData>" + trackMetadata + "</EnqueuedURIMetaData>"
-                    "<AddAtIndex>4294967295</AddAtIndex>";
 
-    String addResp = sendSOAP("AVTransport", "AddURIToSavedQueue", addArgs.c_str());
+        String addResp = sendSOAP("AVTransport", "AddURIToSavedQueue", addArgs.c_str());
 
-    if (addResp.length() > 0 && addResp.indexOf("Fault") < 0) {
-        Serial.println("[FAV] Track added to playlist successfully!");
-        return true;
-    } else {
-        Serial.println("[FAV] Failed to add track");
-        return false;
+        if (addResp.length() > 0 && addResp.indexOf("Fault") < 0) {
+            String newUpdateID = extractXML(addResp, "NewUpdateID");
+            savePlaylistUpdateID = (uint32_t)newUpdateID.toInt();
+            savePlaylistUpdateIDValid = newUpdateID.length() > 0;
+            Serial.println("[FAV] Track added to playlist successfully!");
+            return true;
+        }
+        savePlaylistUpdateIDValid = false;  // Likely changed elsewhere - re-probe and retry
     }
+
+    Serial.println("[FAV] Failed to add track");
+    return false;
 }
 
 String SonosController::browseContent(const char* objectID, int startIndex, int count) {
@@ -828,8 +846,145 @@ bool SonosController::getMute() {
 // State Updates
 // ============================================================================
 void SonosController::notifyUI(UIUpdateType_e type) {
-    UIUpdate_t upd = { type, "" };
-    xQueueSend(uiUpdateQueue, &upd, 0);
+    // Group membership is not in the snapshot - flag it explicitly
+    uint32_t changed = publishSnapshot(type == UPDATE_GROUPS ? SNAP_GROUPS : 0);
+    if (!changed) return;  // Poll returned what the UI already shows
+    // Track, queue and group changes bring the render governor back to full rate;
+    // position ticks, volume and play state only wake the loop to apply them
+    if (changed & (SNAP_CONNECTION | SNAP_TITLE | SNAP_URI | SNAP_QUEUE | SNAP_GROUPS)) governorActivity();
+    else governorWake();
+}
+
+// ============================================================================
+// UI Snapshot (seqlock)
+// ============================================================================
+// SNAP_* bits for the fields that differ between two snapshots
+static uint32_t diffSnapshots(const SonosSnapshot* a, const SonosSnapshot* b) {
+    uint32_t bits = 0;
+    if (a->connected != b->connected) bits |= SNAP_CONNECTION;
+    if (strcmp(a->title, b->title) != 0 || strcmp(a->artist, b->artist) != 0) bits |= SNAP_TITLE;
+    if (strcmp(a->album, b->album) != 0) bits |= SNAP_ALBUM;
+    if (a->relTimeSeconds != b->relTimeSeconds || a->durationSeconds != b->durationSeconds ||
+        strcmp(a->relTime, b->relTime) != 0) bits |= SNAP_POSITION;
+    if (a->isPlaying != b->isPlaying) bits |= SNAP_PLAYSTATE;
+    if (a->volume != b->volume) bits |= SNAP_VOLUME;
+    if (a->isMuted != b->isMuted) bits |= SNAP_MUTE;
+    if (a->shuffleMode != b->shuffleMode) bits |= SNAP_SHUFFLE;
+    if (a->repeatMode != b->repeatMode) bits |= SNAP_REPEAT;
+    if (strcmp(a->roomName, b->roomName) != 0) bits |= SNAP_ROOM;
+    if (strcmp(a->nextTitle, b->nextTitle) != 0 || strcmp(a->nextArtist, b->nextArtist) != 0 ||
+        strcmp(a->nextArtURL, b->nextArtURL) != 0) bits |= SNAP_NEXT;
+    if (strcmp(a->currentURI, b->currentURI) != 0) bits |= SNAP_URI;
+    if (strcmp(a->albumArtURL, b->albumArtURL) != 0 ||
+        strcmp(a->radioStationArtURL, b->radioStationArtURL) != 0) bits |= SNAP_ART;
+    if (a->isRadioStation != b->isRadioStation ||
+        strcmp(a->radioStationName, b->radioStationName) != 0) bits |= SNAP_RADIO;
+    if (a->queueVersion != b->queueVersion || a->queueSize != b->queueSize ||
+        a->currentTrackNumber != b->currentTrackNumber) bits |= SNAP_QUEUE;
+    return bits;
+}
+
+uint32_t SonosController::publishSnapshot(uint32_t extra_bits) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev) return 0;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) return 0;
+
+    SonosSnapshot* st = &snapshotStage;
+    st->connected = dev->connected;
+    st->isPlaying = dev->isPlaying;
+    st->isMuted = dev->isMuted;
+    st->shuffleMode = dev->shuffleMode;
+    st->isRadioStation = dev->isRadioStation;
+    st->repeatMode = dev->repeatMode == "ONE" ? SNAP_REPEAT_ONE
+                   : dev->repeatMode == "ALL" ? SNAP_REPEAT_ALL : SNAP_REPEAT_NONE;
+    st->volume = dev->volume;
+    st->relTimeSeconds = dev->relTimeSeconds;
+    st->durationSeconds = dev->durationSeconds;
+    st->currentTrackNumber = dev->currentTrackNumber;
+    st->queueSize = dev->queueSize;
+    st->queueVersion = queueVersion;
+    strlcpy(st->relTime, dev->relTime.c_str(), sizeof(st->relTime));
+    strlcpy(st->title, dev->currentTrack.c_str(), sizeof(st->title));
+    strlcpy(st->artist, dev->currentArtist.c_str(), sizeof(st->artist));
+    strlcpy(st->album, dev->currentAlbum.c_str(), sizeof(st->album));
+    strlcpy(st->roomName, dev->roomName.c_str(), sizeof(st->roomName));
+    strlcpy(st->radioStationName, dev->radioStationName.c_str(), sizeof(st->radioStationName));
+    strlcpy(st->currentURI, dev->currentURI.c_str(), sizeof(st->currentURI));
+    strlcpy(st->albumArtURL, dev->albumArtURL.c_str(), sizeof(st->albumArtURL));
+    strlcpy(st->radioStationArtURL, dev->radioStationArtURL.c_str(), sizeof(st->radioStationArtURL));
+
+    // Next track: the one after the current, or the first when repeating at the end.
+    // Empty until its page is resident (the polling task fetches it).
+    int nextIdx = nextQueueIndex(dev);
+    QueuePage* pg = nextIdx >= 0 ? findQueuePage(nextIdx) : nullptr;
+    if (pg) {
+        const QueueItem* next = &pg->items[nextIdx - pg->start];
+        strlcpy(st->nextTitle, pg->str(next->title), sizeof(st->nextTitle));
+        strlcpy(st->nextArtist, pg->str(next->artist), sizeof(st->nextArtist));
+        strlcpy(st->nextArtURL, pg->str(next->albumArtURL), sizeof(st->nextArtURL));
+    } else {
+        st->nextTitle[0] = st->nextArtist[0] = st->nextArtURL[0] = '\0';
+    }
+
+    uint32_t changed = diffSnapshots(st, &snapshot);
+    if (changed) {
+        st->version = snapshot.version + 1;
+        uint32_t seq = snapshotSeq;
+        __atomic_store_n(&snapshotSeq, seq + 1, __ATOMIC_RELAXED);   // Odd: readers retry
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(&snapshot, st, sizeof(snapshot));
+        __atomic_store_n(&snapshotSeq, seq + 2, __ATOMIC_RELEASE);
+    }
+    changed |= extra_bits;
+    if (changed) pushUIChange(changed, st);
+    xSemaphoreGive(deviceMutex);
+    return changed;
+}
+
+// Producer side of the UI ring - called with deviceMutex held (single producer)
+void SonosController::pushUIChange(uint32_t mask, const SonosSnapshot* st) {
+    uint32_t head = uiRingHead;
+    uint32_t tail = __atomic_load_n(&uiRingTail, __ATOMIC_ACQUIRE);
+    if (head - tail >= SONOS_UI_RING_SIZE) {
+        // UI stalled (e.g. OTA) - fold into the overflow mask, nothing is lost
+        __atomic_fetch_or(&uiRingOverflow, mask, __ATOMIC_RELEASE);
+        return;
+    }
+    UIChangeSet* cs = &uiRing[head % SONOS_UI_RING_SIZE];
+    cs->mask = mask;
+    cs->relTimeSeconds = st->relTimeSeconds;
+    cs->durationSeconds = st->durationSeconds;
+    cs->volume = st->volume;
+    cs->repeatMode = st->repeatMode;
+    cs->flags = (st->connected ? UI_CS_CONNECTED : 0) | (st->isPlaying ? UI_CS_PLAYING : 0) |
+                (st->isMuted ? UI_CS_MUTED : 0) | (st->shuffleMode ? UI_CS_SHUFFLE : 0);
+    __atomic_store_n(&uiRingHead, head + 1, __ATOMIC_RELEASE);
+}
+
+bool SonosController::popUIChange(UIChangeSet* out) {
+    uint32_t tail = uiRingTail;
+    if (tail == __atomic_load_n(&uiRingHead, __ATOMIC_ACQUIRE)) return false;
+    *out = uiRing[tail % SONOS_UI_RING_SIZE];
+    __atomic_store_n(&uiRingTail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t SonosController::takeUIOverflow() {
+    return __atomic_exchange_n(&uiRingOverflow, 0, __ATOMIC_ACQUIRE);
+}
+
+uint32_t SonosController::readSnapshot(SonosSnapshot* out) {
+    for (;;) {
+        uint32_t seq = __atomic_load_n(&snapshotSeq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            taskYIELD();  // Writer mid-publish
+            continue;
+        }
+        memcpy(out, &snapshot, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&snapshotSeq, __ATOMIC_RELAXED) == seq) break;
+    }
+    return out->version;
 }
 
 // Helper: Detect if URI is a radio station
@@ -1040,6 +1195,7 @@ bool SonosController::updateMediaInfo() {
         }
 
         xSemaphoreGive(deviceMutex);
+        publishSnapshot();
         return true;
     }
     return false;
@@ -1101,64 +1257,811 @@ bool SonosController::updateTransportSettings() {
     return false;
 }
 
-bool SonosController::updateQueue() {
-    String resp = sendSOAP("ContentDirectory", "Browse",
+// ============================================================================
+// Windowed Queue
+// ============================================================================
+static inline int queuePageStart(int index) {
+    return index - index % SONOS_QUEUE_BATCH_SIZE;
+}
+
+static_assert(SONOS_QUEUE_SIZE_MAX / SONOS_QUEUE_BATCH_SIZE <= 32, "queuePagePending has one bit per list page");
+
+QueuePage* SonosController::findQueuePage(int index) {
+    if (index < 0) return nullptr;
+    int start = queuePageStart(index);
+    for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+        QueuePage* pg = &queuePages[i];
+        if (pg->start == start && index - start < pg->count) {
+            pg->lastUse = millis();
+            return pg;
+        }
+    }
+    return nullptr;
+}
+
+// Resident and not cut short by a local edit
+bool SonosController::queuePageFull(int start) {
+    SonosDevice* dev = getCurrentDevice();
+    QueuePage* pg = findQueuePage(start);
+    return pg && dev && pg->count >= min(SONOS_QUEUE_BATCH_SIZE, dev->totalTracks - start);
+}
+
+// Slot for a page: the same page, a free slot, or the page farthest from both the
+// current track and the list view (ties: least recently used)
+QueuePage* SonosController::allocQueuePage(int start) {
+    SonosDevice* dev = getCurrentDevice();
+    int cur = dev && dev->currentTrackNumber > 0 ? queuePageStart(dev->currentTrackNumber - 1) : 0;
+    int view = queueViewIndex >= 0 ? queuePageStart(queueViewIndex) : cur;
+    QueuePage* victim = nullptr;
+    int victim_dist = -1;
+    for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+        QueuePage* pg = &queuePages[i];
+        if (pg->start == start || pg->start < 0) return pg;
+        int dist = min(abs(pg->start - cur), abs(pg->start - view));
+        if (dist > victim_dist || (dist == victim_dist && pg->lastUse < victim->lastUse)) {
+            victim = pg;
+            victim_dist = dist;
+        }
+    }
+    return victim;
+}
+
+void SonosController::resetQueuePages() {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) queuePages[i].start = -1;
+    queueUpdateIDValid = false;
+    markQueueDirty(0, SONOS_QUEUE_SIZE_MAX - 1);
+    queueVersion++;
+    xSemaphoreGive(deviceMutex);
+}
+
+// Widen the range the UI has to rebind (deviceMutex held)
+void SonosController::markQueueDirty(int first, int last) {
+    if (last < first) return;
+    if (queueDirtyFirst < 0 || first < queueDirtyFirst) queueDirtyFirst = first;
+    if (last > queueDirtyLast) queueDirtyLast = last;
+}
+
+bool SonosController::takeQueueDirtyRange(int* first, int* last) {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
+        // Can't tell what changed - rebind everything
+        *first = 0;
+        *last = SONOS_QUEUE_SIZE_MAX - 1;
+        return true;
+    }
+    *first = queueDirtyFirst;
+    *last = queueDirtyLast;
+    queueDirtyFirst = -1;
+    queueDirtyLast = -1;
+    xSemaphoreGive(deviceMutex);
+    return *first >= 0;
+}
+
+// ============================================================================
+// Queue page arena - each page keeps its strings in one fixed PSRAM block instead
+// of ~4 heap Strings per item; refetches reuse the block, so nothing fragments
+// ============================================================================
+static_assert(SONOS_QUEUE_ARENA_SIZE <= 65535, "queue arena offsets are 16-bit");
+static_assert((SONOS_QUEUE_INTERN_SLOTS & (SONOS_QUEUE_INTERN_SLOTS - 1)) == 0 &&
+              SONOS_QUEUE_INTERN_SLOTS > 3 * SONOS_QUEUE_BATCH_SIZE, "intern table must never fill");
+
+static struct {
+    uint32_t strings;        // Copies stored
+    uint32_t interned;       // Lookups answered by an existing copy
+    uint32_t savedBytes;     // What those copies would have taken
+    uint32_t dropped;        // Strings lost to a full arena (stored as "")
+} queueArenaStats;
+
+static void queueArenaReset(QueuePage* pg) {
+    pg->arena[0] = '\0';
+    pg->arenaUsed = 1;
+    memset(pg->internSlots, 0, sizeof(pg->internSlots));
+}
+
+// Copy a string into the page's arena. Interned strings (artist, album, art URL)
+// return the page's existing copy when there is one.
+static uint16_t queueArenaPut(QueuePage* pg, const char* s, bool intern) {
+    size_t len = strlen(s);
+    if (len == 0) return 0;
+    uint32_t slot = 0;
+    if (intern) {
+        uint32_t h = 2166136261u;  // FNV-1a
+        for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)s[i]) * 16777619u;
+        slot = h & (SONOS_QUEUE_INTERN_SLOTS - 1);
+        int probes = 0;
+        for (; pg->internSlots[slot]; slot = (slot + 1) & (SONOS_QUEUE_INTERN_SLOTS - 1)) {
+            if (strcmp(pg->str(pg->internSlots[slot]), s) == 0) {
+                queueArenaStats.interned++;
+                queueArenaStats.savedBytes += len + 1;
+                return pg->internSlots[slot];
+            }
+            if (++probes == SONOS_QUEUE_INTERN_SLOTS) {
+                intern = false;  // Table full - store an uninterned copy
+                break;
+            }
+        }
+    }
+    if (pg->arenaUsed + len + 1 > SONOS_QUEUE_ARENA_SIZE) {
+        queueArenaStats.dropped++;
+        return 0;
+    }
+    uint16_t off = pg->arenaUsed;
+    memcpy(pg->arena + off, s, len + 1);
+    pg->arenaUsed += len + 1;
+    queueArenaStats.strings++;
+    if (intern) pg->internSlots[slot] = off;
+    return off;
+}
+
+static bool sameQueueItem(const QueuePage* a, const QueueItem* x, const QueuePage* b, const QueueItem* y) {
+    return strcmp(a->str(x->title), b->str(y->title)) == 0 &&
+           strcmp(a->str(x->artist), b->str(y->artist)) == 0 &&
+           strcmp(a->str(x->album), b->str(y->album)) == 0 &&
+           strcmp(a->str(x->albumArtURL), b->str(y->albumArtURL)) == 0;
+}
+
+// Move the parsed stage into a slot - swapping arenas, so no string is copied
+void SonosController::commitQueuePage(QueuePage* pg) {
+    char* spare = pg->arena;
+    *pg = queueStage;
+    queueStage.arena = spare;
+}
+
+void SonosController::logQueueStats() {
+    uint32_t used = 0;
+    int pages = 0;
+    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
+        for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+            if (queuePages[i].start < 0) continue;
+            used += queuePages[i].arenaUsed;
+            pages++;
+        }
+        xSemaphoreGive(deviceMutex);
+    }
+    if (queueArenaStats.strings == 0) return;
+    Serial.printf("[QUEUE] %d pages, arena %lu/%lu bytes | %lu strings, %lu interned (%lu bytes saved), %lu dropped\n",
+                  pages, (unsigned long)used, (unsigned long)(SONOS_QUEUE_PAGE_SLOTS * SONOS_QUEUE_ARENA_SIZE),
+                  (unsigned long)queueArenaStats.strings, (unsigned long)queueArenaStats.interned,
+                  (unsigned long)queueArenaStats.savedBytes, (unsigned long)queueArenaStats.dropped);
+}
+
+// Queue index of the track after the current one, -1 = none
+int SonosController::nextQueueIndex(const SonosDevice* dev) {
+    if (dev->isRadioStation || dev->totalTracks <= 0 || dev->currentTrackNumber <= 0) return -1;
+    int next = dev->currentTrackNumber;  // 0-based index of track N+1
+    if (next < dev->totalTracks) return next;
+    return (dev->repeatMode == "ALL" || dev->repeatMode == "ONE") ? 0 : -1;
+}
+
+// Browse one page of Q:0 into the cache (caller notifies the UI)
+bool SonosController::fetchQueuePage(int start) {
+    char args[320];
+    snprintf(args, sizeof(args),
         "<ObjectID>Q:0</ObjectID>"
         "<BrowseFlag>BrowseDirectChildren</BrowseFlag>"
         "<Filter>*</Filter>"
-        "<StartingIndex>0</StartingIndex>"
-        "<RequestedCount>50</RequestedCount>"
-        "<SortCriteria></SortCriteria>");
-    
+        "<StartingIndex>%d</StartingIndex>"
+        "<RequestedCount>%d</RequestedCount>"
+        "<SortCriteria></SortCriteria>", start, SONOS_QUEUE_BATCH_SIZE);
+    uint32_t editSeq = queueEditSeq;
+    String resp = sendSOAP("ContentDirectory", "Browse", args);
+
     if (resp.length() == 0) {
         Serial.printf("[SONOS] Queue response empty\n");
         return false;
     }
-    
+    if (!queueStage.arena) return false;  // Arena allocation failed in begin()
+
     SonosDevice* dev = getCurrentDevice();
     if (!dev) return false;
-    
-    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
-        String total = extractXML(resp, "TotalMatches");
-        if (total.length() > 0) {
-            dev->totalTracks = total.toInt();
+
+    // Get the Result which contains DIDL-Lite (decoded outside the mutex)
+    String total = extractXML(resp, "TotalMatches");
+    String updateID = extractXML(resp, "UpdateID");
+    String result = decodeHTML(extractXML(resp, "Result"));
+
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return false;
+    if (queueEditSeq != editSeq || queueEditTail != queueEditHead) {
+        // Local edits the speaker hasn't seen yet - this page predates them
+        xSemaphoreGive(deviceMutex);
+        return false;
+    }
+    if (total.length() > 0) {
+        dev->totalTracks = total.toInt();
+        dev->queueSize = min(dev->totalTracks, SONOS_QUEUE_SIZE_MAX);
+    }
+    // Queue changed since the last probe - this page is newer than the others
+    if (updateID.length() > 0 && queueUpdateIDValid && (uint32_t)updateID.toInt() != queueUpdateID) {
+        queueUpdateIDValid = false;
+    }
+
+    // Parse into the stage, then diff against the resident copy (a new page is all new)
+    QueuePage* stage = &queueStage;
+    queueArenaReset(stage);
+    stage->start = start;
+    stage->count = 0;
+    stage->generation = queueGeneration;
+    stage->lastUse = millis();
+    int pos = 0;
+
+    while (stage->count < SONOS_QUEUE_BATCH_SIZE && pos < (int)result.length()) {
+        int itemStart = result.indexOf("<item", pos);
+        if (itemStart < 0) break;
+
+        int itemEnd = result.indexOf("</item>", itemStart);
+        if (itemEnd < 0) break;
+
+        // Use range-based extraction to avoid creating substring copy
+        QueueItem* item = &stage->items[stage->count];
+        item->title = queueArenaPut(stage, decodeHTML(extractXMLRange(result, "dc:title", itemStart, itemEnd)).c_str(), false);
+        item->artist = queueArenaPut(stage, decodeHTML(extractXMLRange(result, "dc:creator", itemStart, itemEnd)).c_str(), true);
+        item->album = queueArenaPut(stage, decodeHTML(extractXMLRange(result, "upnp:album", itemStart, itemEnd)).c_str(), true);
+        item->albumArtURL = queueArenaPut(stage, decodeHTML(extractXMLRange(result, "upnp:albumArtURI", itemStart, itemEnd)).c_str(), true);
+        stage->count++;
+
+        pos = itemEnd + 7;
+    }
+
+    QueuePage* pg = allocQueuePage(start);
+    int oldCount = pg->start == start ? pg->count : 0;
+    int dirtyFirst = -1, dirtyLast = -1;
+    for (int i = 0; i < stage->count; i++) {
+        if (i < oldCount && sameQueueItem(pg, &pg->items[i], stage, &stage->items[i])) continue;
+        if (dirtyFirst < 0) dirtyFirst = start + i;
+        dirtyLast = start + i;
+    }
+    if (stage->count < oldCount) {
+        if (dirtyFirst < 0) dirtyFirst = start + stage->count;
+        dirtyLast = start + oldCount - 1;
+    }
+    commitQueuePage(pg);
+    if (pg->count == 0) pg->start = -1;  // Past the end (queue shrank) - nothing to keep
+
+    if (dirtyFirst >= 0) {
+        markQueueDirty(dirtyFirst, dirtyLast);
+        queueVersion++;
+        Serial.printf("[SONOS] Queue page %d-%d of %d (changed %d-%d, arena %u bytes)\n", start, start + pg->count - 1,
+                      dev->totalTracks, dirtyFirst, dirtyLast, (unsigned)pg->arenaUsed);
+    } else {
+        Serial.printf("[SONOS] Queue page %d-%d of %d unchanged\n", start, start + pg->count - 1, dev->totalTracks);
+    }
+    xSemaphoreGive(deviceMutex);
+    return true;
+}
+
+// Cheap change probe: BrowseMetadata returns only the container itself (a few hundred
+// bytes) with its UpdateID, which Sonos bumps on every edit, and its childCount
+// (-1 if absent). Used for the queue (Q:0) and for cached browse folders.
+bool SonosController::probeContainer(const char* objectID, uint32_t* updateID, int* childCount) {
+    char args[320];  // Polling and network task both probe
+    snprintf(args, sizeof(args),
+        "<ObjectID>%s</ObjectID>"
+        "<BrowseFlag>BrowseMetadata</BrowseFlag>"
+        "<Filter></Filter>"
+        "<StartingIndex>0</StartingIndex>"
+        "<RequestedCount>1</RequestedCount>"
+        "<SortCriteria></SortCriteria>", objectID);
+    String resp = sendSOAP("ContentDirectory", "Browse", args);
+    String id = extractXML(resp, "UpdateID");
+    if (id.length() == 0) return false;
+    *updateID = (uint32_t)id.toInt();
+    if (!childCount) return true;
+
+    // Result is still entity-encoded here: childCount=&quot;N&quot;
+    *childCount = -1;
+    int p = resp.indexOf("childCount=");
+    if (p < 0) return true;
+    p += 11;
+    while (p < (int)resp.length() && !isdigit((unsigned char)resp[p]) && resp[p] != '<') p++;
+    if (p < (int)resp.length() && isdigit((unsigned char)resp[p])) *childCount = atoi(resp.c_str() + p);
+    return true;
+}
+
+// Refresh the pages that matter now (current track, next track, list view). While the
+// queue's UpdateID is unchanged resident pages are kept and only missing ones fetched;
+// on a change they are refetched and diffed, and pages nobody needs are dropped.
+// Without an UpdateID (probe failed) the refetch falls back to the old fixed cadence,
+// one every SONOS_QUEUE_UNPROBED_MS; calls in between only fetch missing pages.
+bool SonosController::updateQueue() {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev) return false;
+    if (queueEditBusy) return true;  // processQueueEdits() reconciles once the batch is sent
+
+    uint32_t id = 0;
+    int childCount = -1;
+    bool probed = probeContainer("Q:0", &id, &childCount);
+
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return false;
+    if (childCount >= 0) {
+        dev->totalTracks = childCount;
+        dev->queueSize = min(childCount, SONOS_QUEUE_SIZE_MAX);
+    }
+    bool changed = !probed || !queueUpdateIDValid || id != queueUpdateID;
+    if (!probed && queueUnprobedMs != 0 && millis() - queueUnprobedMs < SONOS_QUEUE_UNPROBED_MS) changed = false;
+    if (changed) {
+        queueGeneration++;
+        queueUpdateID = id;
+        queueUpdateIDValid = probed;
+        queueUnprobedMs = probed ? 0 : (millis() | 1);
+    }
+    int cur = dev->currentTrackNumber > 0 ? dev->currentTrackNumber - 1 : 0;
+    int next = nextQueueIndex(dev);
+    int wanted[3] = { queuePageStart(cur), -1, -1 };
+    if (next >= 0) wanted[1] = queuePageStart(next);
+    if (queueViewIndex >= 0 && queueViewIndex < dev->queueSize) wanted[2] = queuePageStart(queueViewIndex);
+    bool fetch[3];
+    for (int i = 0; i < 3; i++) {
+        bool dup = wanted[i] < 0 || (i > 0 && wanted[i] == wanted[0]) || (i == 2 && wanted[2] == wanted[1]);
+        fetch[i] = !dup && (changed || (wanted[i] < dev->totalTracks && !queuePageFull(wanted[i])));
+    }
+    xSemaphoreGive(deviceMutex);
+
+    if (!changed && !fetch[0] && !fetch[1] && !fetch[2]) return true;  // Nothing to do - one probe
+
+    for (int i = 0; i < 3; i++) {
+        if (!fetch[i] || fetchQueuePage(wanted[i])) continue;
+        if (i == 0) {
+            // Retry the whole refresh next time instead of trusting stale pages
+            if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+                queueUpdateIDValid = false;
+                xSemaphoreGive(deviceMutex);
+            }
+            return false;
         }
-        
-        String numReturned = extractXML(resp, "NumberReturned");
-        Serial.printf("[SONOS] Queue: total=%d, returned=%s\n", dev->totalTracks, numReturned.c_str());
-        
-        // Get the Result which contains DIDL-Lite
-        String result = extractXML(resp, "Result");
-        result = decodeHTML(result);
-        
-        dev->queueSize = 0;
-        int pos = 0;
-        
-        while (dev->queueSize < QUEUE_ITEMS_MAX && pos < (int)result.length()) {
-            int itemStart = result.indexOf("<item", pos);
-            if (itemStart < 0) break;
-
-            int itemEnd = result.indexOf("</item>", itemStart);
-            if (itemEnd < 0) break;
-
-            // Use range-based extraction to avoid creating substring copy
-            dev->queue[dev->queueSize].title = decodeHTML(extractXMLRange(result, "dc:title", itemStart, itemEnd));
-            dev->queue[dev->queueSize].artist = decodeHTML(extractXMLRange(result, "dc:creator", itemStart, itemEnd));
-            dev->queue[dev->queueSize].album = decodeHTML(extractXMLRange(result, "upnp:album", itemStart, itemEnd));
-            dev->queue[dev->queueSize].albumArtURL = decodeHTML(extractXMLRange(result, "upnp:albumArtURI", itemStart, itemEnd));
-            dev->queue[dev->queueSize].trackNumber = dev->queueSize + 1;
-            dev->queueSize++;
-
-            pos = itemEnd + 7;
+    }
+
+    if (changed && xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) {
+        for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+            QueuePage* pg = &queuePages[i];
+            if (pg->start < 0 || pg->generation == queueGeneration) continue;
+            markQueueDirty(pg->start, pg->start + pg->count - 1);
+            pg->start = -1;
+            queueVersion++;
         }
-        
-        Serial.printf("[SONOS] Parsed %d queue items\n", dev->queueSize);
+        xSemaphoreGive(deviceMutex);
+    }
+    notifyUI(UPDATE_QUEUE);  // No-op unless the snapshot changed
+    return true;
+}
 
+// Track changes can move the next track onto a page that isn't loaded (e.g. 49 -> 50)
+bool SonosController::ensureNextQueuePage() {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev) return false;
+    int next = -1;
+    bool resident = true;
+    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) {
+        next = nextQueueIndex(dev);
+        resident = next < 0 || findQueuePage(next) != nullptr;
         xSemaphoreGive(deviceMutex);
-        notifyUI(UPDATE_QUEUE);
-        return true;
     }
-    return false;
+    if (resident) return false;
+    if (!fetchQueuePage(queuePageStart(next))) return false;
+    notifyUI(UPDATE_QUEUE);
+    return true;
+}
+
+bool SonosController::getQueueItem(int index, QueueItemView* out) {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) return false;
+    QueuePage* pg = findQueuePage(index);
+    if (pg) {
+        const QueueItem* item = &pg->items[index - pg->start];
+        strlcpy(out->title, pg->str(item->title), sizeof(out->title));
+        strlcpy(out->artist, pg->str(item->artist), sizeof(out->artist));
+        strlcpy(out->albumArtURL, pg->str(item->albumArtURL), sizeof(out->albumArtURL));
+    }
+    xSemaphoreGive(deviceMutex);
+    return pg != nullptr;
+}
+
+// Called by the queue list on every layout - queues a fetch for missing pages
+void SonosController::setQueueView(int first, int last) {
+    queueViewIndex = first;
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || first < 0) return;
+    if (last >= dev->queueSize) last = dev->queueSize - 1;
+    for (int start = queuePageStart(first); start <= last; start += SONOS_QUEUE_BATCH_SIZE) {
+        uint32_t bit = 1u << (start / SONOS_QUEUE_BATCH_SIZE);
+        if (__atomic_load_n(&queuePagePending, __ATOMIC_ACQUIRE) & bit) continue;
+        bool resident = false;
+        if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
+            resident = queuePageFull(start);
+            xSemaphoreGive(deviceMutex);
+        }
+        if (resident) continue;
+        CommandRequest_t cmd = { CMD_FETCH_QUEUE_PAGE, start };
+        if (xQueueSend(commandQueue, &cmd, 0) == pdTRUE) __atomic_fetch_or(&queuePagePending, bit, __ATOMIC_RELEASE);
+    }
+}
+
+void SonosController::injectQueuePage(int start, int count, int total, void (*fill)(int index, QueueItemView* item)) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || !queueStage.arena || !xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(100))) return;
+    if (count > SONOS_QUEUE_BATCH_SIZE) count = SONOS_QUEUE_BATCH_SIZE;
+    static QueueItemView view;  // Guarded by deviceMutex
+    QueuePage* stage = &queueStage;
+    queueArenaReset(stage);
+    stage->start = start;
+    stage->count = count;
+    stage->generation = queueGeneration;
+    stage->lastUse = millis();
+    for (int i = 0; i < count; i++) {
+        memset(&view, 0, sizeof(view));
+        fill(start + i, &view);
+        QueueItem* item = &stage->items[i];
+        item->title = queueArenaPut(stage, view.title, false);
+        item->artist = queueArenaPut(stage, view.artist, true);
+        item->album = 0;
+        item->albumArtURL = queueArenaPut(stage, view.albumArtURL, true);
+    }
+    commitQueuePage(allocQueuePage(start));
+    dev->totalTracks = total;
+    dev->queueSize = min(total, SONOS_QUEUE_SIZE_MAX);
+    markQueueDirty(start, start + count - 1);
+    queueUpdateIDValid = false;  // Not the speaker's queue - the next refresh refetches
+    queueVersion++;
+    xSemaphoreGive(deviceMutex);
+}
+
+// ============================================================================
+// Queue Editing - edits are applied to the resident pages when posted and sent by
+// the network task in one batch; a single Q:0 probe afterwards confirms the result
+// ============================================================================
+static void copyQueueItem(QueuePage* dst, QueueItem* to, const QueuePage* src, const QueueItem* from) {
+    to->title = queueArenaPut(dst, src->str(from->title), false);
+    to->artist = queueArenaPut(dst, src->str(from->artist), true);
+    to->album = queueArenaPut(dst, src->str(from->album), true);
+    to->albumArtURL = queueArenaPut(dst, src->str(from->albumArtURL), true);
+}
+
+// Insert (delta > 0) or remove (-delta) tracks at index `at` in the resident pages and
+// the queue length. Each touched page is rebuilt into the stage and committed, so its
+// arena holds only the strings it still uses however many edits come in before the
+// next refetch. Where a source isn't resident (or an inserted track isn't known) the
+// page is cut short and the rest is fetched again. deviceMutex held.
+void SonosController::shiftQueuePages(int at, int delta, const QueueItemView* inserted, const char* album) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || delta == 0) return;
+    int total = dev->totalTracks + delta;
+
+    // Removal pulls items from later pages, insertion from earlier ones - rewrite pages
+    // in that direction so every source is read before its own page changes
+    QueuePage* order[SONOS_QUEUE_PAGE_SLOTS];
+    int pages = 0;
+    for (int i = 0; i < SONOS_QUEUE_PAGE_SLOTS; i++) {
+        if (queuePages[i].start >= 0 && queuePages[i].start + SONOS_QUEUE_BATCH_SIZE > at) order[pages++] = &queuePages[i];
+    }
+    for (int i = 1; i < pages; i++) {
+        for (int j = i; j > 0 && (delta < 0) == (order[j]->start < order[j - 1]->start); j--) {
+            QueuePage* t = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = t;
+        }
+    }
+
+    for (int p = 0; p < pages; p++) {
+        QueuePage* pg = order[p];
+        int start = pg->start;
+        int oldCount = pg->count;
+        int limit = min(SONOS_QUEUE_BATCH_SIZE, total - start);
+
+        // Longest prefix whose items are all known
+        int count = 0;
+        for (; count < limit; count++) {
+            int j = start + count;
+            if (j < at) {
+                if (count >= oldCount) break;
+            } else if (j < at + delta) {
+                if (!inserted) break;
+            } else if (!findQueuePage(j - delta)) {
+                break;
+            }
+        }
+
+        QueuePage* stage = &queueStage;
+        queueArenaReset(stage);
+        stage->start = start;
+        stage->count = count;
+        stage->generation = pg->generation;
+        stage->lastUse = pg->lastUse;
+        for (int j = start; j < start + count; j++) {
+            QueueItem* item = &stage->items[j - start];
+            if (j < at) {
+                copyQueueItem(stage, item, pg, &pg->items[j - start]);
+            } else if (j < at + delta) {
+                item->title = queueArenaPut(stage, inserted->title, false);
+                item->artist = queueArenaPut(stage, inserted->artist, true);
+                item->album = queueArenaPut(stage, album, true);
+                item->albumArtURL = queueArenaPut(stage, inserted->albumArtURL, true);
+            } else {
+                QueuePage* src = findQueuePage(j - delta);
+                copyQueueItem(stage, item, src, &src->items[j - delta - src->start]);
+            }
+        }
+        commitQueuePage(pg);
+        markQueueDirty(max(at, start), start + max(oldCount, count) - 1);
+        if (count == 0) pg->start = -1;
+    }
+
+    dev->totalTracks = total;
+    dev->queueSize = min(total, SONOS_QUEUE_SIZE_MAX);
+    queueVersion++;
+}
+
+// One track from `from` to final index `to`, current track following it. deviceMutex held.
+void SonosController::moveQueueTrack(int from, int to) {
+    SonosDevice* dev = getCurrentDevice();
+    static QueueItemView moved;  // Guarded by deviceMutex
+    static char movedAlbum[SNAP_TEXT_LEN];
+    QueuePage* pg = findQueuePage(from);
+    if (pg) {
+        const QueueItem* item = &pg->items[from - pg->start];
+        strlcpy(moved.title, pg->str(item->title), sizeof(moved.title));
+        strlcpy(moved.artist, pg->str(item->artist), sizeof(moved.artist));
+        strlcpy(moved.albumArtURL, pg->str(item->albumArtURL), sizeof(moved.albumArtURL));
+        strlcpy(movedAlbum, pg->str(item->album), sizeof(movedAlbum));
+    }
+    shiftQueuePages(from, -1, nullptr, nullptr);
+    shiftQueuePages(to, 1, pg ? &moved : nullptr, movedAlbum);
+
+    int cur = dev->currentTrackNumber - 1;
+    if (cur < 0) return;
+    if (cur == from) dev->currentTrackNumber = to + 1;
+    else if (from < cur && cur <= to) dev->currentTrackNumber--;
+    else if (to <= cur && cur < from) dev->currentTrackNumber++;
+}
+
+// Next ring slot, or null when full. Edits can't go in behind a container add whose
+// track count is still unknown - their indexes would miss its tracks. deviceMutex held.
+QueueEdit* SonosController::allocQueueEdit(uint8_t op, bool* kick) {
+    if (queueEditDropPending || queueEditHead - queueEditTail >= SONOS_QUEUE_EDIT_SLOTS) return nullptr;
+    for (uint32_t i = queueEditTail; i != queueEditHead; i++) {
+        const QueueEdit* e = &queueEdits[i % SONOS_QUEUE_EDIT_SLOTS];
+        if (e->op == QUEUE_EDIT_ADD && !e->applied) return nullptr;
+    }
+    QueueEdit* e = &queueEdits[queueEditHead++ % SONOS_QUEUE_EDIT_SLOTS];
+    e->op = op;
+    e->next = false;
+    e->applied = true;
+    e->first = 0;
+    e->count = 0;
+    e->to = 0;
+    e->uri = String();
+    e->meta = String();
+    queueEditSeq++;
+    *kick = !queueEditBusy;  // A running batch picks it up
+    queueEditBusy = true;
+    return e;
+}
+
+void SonosController::postQueueEdits(bool kick) {
+    if (kick) {
+        CommandRequest_t cmd = { CMD_QUEUE_EDIT, 0 };
+        if (xQueueSend(commandQueue, &cmd, 0) != pdTRUE) {
+            // Never sent - drop the batch and let the next poll refetch the real queue.
+            // The UI doesn't wait long on the mutex: the network task drops it otherwise.
+            Serial.println("[QUEUE] Command queue full - edit dropped");
+            queueEditDropPending = true;
+            if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) {
+                dropQueueEdits();
+                xSemaphoreGive(deviceMutex);
+            }
+        }
+    }
+    notifyUI(UPDATE_QUEUE);
+}
+
+// deviceMutex held
+void SonosController::dropQueueEdits() {
+    queueEditTail = queueEditHead;
+    queueEditBusy = false;
+    queueUpdateIDValid = false;
+    queueEditDropPending = false;
+}
+
+bool SonosController::removeQueueTracks(int first, int count) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || first < 0 || count <= 0) return false;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) return false;
+    count = min(count, dev->totalTracks - first);
+    bool kick = false;
+    QueueEdit* e = count > 0 ? allocQueueEdit(QUEUE_EDIT_REMOVE, &kick) : nullptr;
+    if (e) {
+        e->first = first;
+        e->count = count;
+        int cur = dev->currentTrackNumber - 1;
+        shiftQueuePages(first, -count, nullptr, nullptr);
+        if (cur >= first + count) dev->currentTrackNumber -= count;
+    }
+    xSemaphoreGive(deviceMutex);
+    if (!e) return false;
+    postQueueEdits(kick);
+    return true;
+}
+
+bool SonosController::moveQueueTracks(int first, int count, int to) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || first < 0 || count <= 0 || to < 0 || to == first) return false;
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) return false;
+    bool kick = false;
+    QueueEdit* e = nullptr;
+    if (first + count <= dev->totalTracks && to + count <= dev->totalTracks) e = allocQueueEdit(QUEUE_EDIT_MOVE, &kick);
+    if (e) {
+        e->first = first;
+        e->count = count;
+        e->to = to;
+        // A block move is count single-track moves here, one ReorderTracksInQueue remotely
+        for (int k = 0; k < count; k++) {
+            if (to < first) moveQueueTrack(first + k, to + k);
+            else moveQueueTrack(first, to + count - 1);
+        }
+    }
+    xSemaphoreGive(deviceMutex);
+    if (!e) return false;
+    postQueueEdits(kick);
+    return true;
+}
+
+// Callers: LVGL thread (browse rows)
+bool SonosController::enqueueURI(const char* uri, const char* meta, bool next) {
+    SonosDevice* dev = getCurrentDevice();
+    if (!dev || !uri || !uri[0]) return false;
+    if (!meta) meta = "";
+
+    // A single track shows up at once; containers once the speaker says how many
+    // tracks they added. Parsed before taking the mutex.
+    static QueueItemView track;
+    static char album[SNAP_TEXT_LEN];
+    bool single = strstr(meta, "object.item.audioItem.musicTrack") != nullptr;
+    if (single) {
+        String m = meta;
+        strlcpy(track.title, decodeHTML(extractXML(m, "dc:title")).c_str(), sizeof(track.title));
+        strlcpy(track.artist, decodeHTML(extractXML(m, "dc:creator")).c_str(), sizeof(track.artist));
+        strlcpy(track.albumArtURL, decodeHTML(extractXML(m, "upnp:albumArtURI")).c_str(), sizeof(track.albumArtURL));
+        strlcpy(album, decodeHTML(extractXML(m, "upnp:album")).c_str(), sizeof(album));
+    }
+
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) return false;
+    bool kick = false;
+    QueueEdit* e = allocQueueEdit(QUEUE_EDIT_ADD, &kick);
+    if (e) {
+        int cur = dev->currentTrackNumber;
+        e->next = next && cur > 0 && !dev->isRadioStation;
+        e->first = e->next ? min(cur, dev->totalTracks) : dev->totalTracks;
+        e->uri = uri;
+        e->meta = meta;
+        e->applied = single;
+        if (single) {
+            e->count = 1;
+            shiftQueuePages(e->first, 1, &track, album);
+            if (cur > e->first) dev->currentTrackNumber++;
+        }
+    }
+    xSemaphoreGive(deviceMutex);
+    if (!e) return false;
+    postQueueEdits(kick);
+    return true;
+}
+
+// Network task. *exact is cleared when the speaker's result differs from the local edit.
+bool SonosController::sendQueueEdit(QueueEdit* e, bool* exact) {
+    char args[320];
+    String resp;
+    // UpdateID 0 skips the speaker's check - indexes come from the local model, and
+    // the probe after the batch catches edits made elsewhere meanwhile
+    switch (e->op) {
+        case QUEUE_EDIT_REMOVE:
+            snprintf(args, sizeof(args),
+                "<InstanceID>0</InstanceID>"
+                "<UpdateID>0</UpdateID>"
+                "<StartingIndex>%d</StartingIndex>"
+                "<NumberOfTracks>%d</NumberOfTracks>", e->first + 1, e->count);
+            resp = sendSOAP("AVTransport", "RemoveTrackRangeFromQueue", args);
+            break;
+
+        case QUEUE_EDIT_MOVE:
+            // InsertBefore counts in the queue before the move
+            snprintf(args, sizeof(args),
+                "<InstanceID>0</InstanceID>"
+                "<StartingIndex>%d</StartingIndex>"
+                "<NumberOfTracks>%d</NumberOfTracks>"
+                "<InsertBefore>%d</InsertBefore>"
+                "<UpdateID>0</UpdateID>", e->first + 1, e->count,
+                e->to < e->first ? e->to + 1 : e->to + e->count + 1);
+            resp = sendSOAP("AVTransport", "ReorderTracksInQueue", args);
+            break;
+
+        case QUEUE_EDIT_ADD: {
+            String uri = e->uri;
+            String meta = e->meta;
+            encodeXML(uri);
+            encodeXML(meta);
+            String addArgs = "<InstanceID>0</InstanceID>"
+                             "<EnqueuedURI>" + uri + "</EnqueuedURI>"
+                             "<EnqueuedURIMetaData>" + meta + "</EnqueuedURIMetaData>"
+                             "<DesiredFirstTrackNumberEnqueued>" + String(e->next ? e->first + 1 : 0) +
+                             "</DesiredFirstTrackNumberEnqueued>"
+                             "<EnqueueAsNext>" + String(e->next ? 1 : 0) + "</EnqueueAsNext>";
+            resp = sendSOAP("AVTransport", "AddURIToQueue", addArgs.c_str());
+            break;
+        }
+    }
+
+    if (resp.length() == 0 || resp.indexOf("Fault") >= 0) {
+        Serial.printf("[QUEUE] Edit %d at %d failed\n", e->op, e->first + 1);
+        return false;
+    }
+    if (e->op != QUEUE_EDIT_ADD) return true;
+
+    int added = extractXML(resp, "NumTracksAdded").toInt();
+    int at = extractXML(resp, "FirstTrackNumberEnqueued").toInt() - 1;
+    xSemaphoreTake(deviceMutex, portMAX_DELAY);
+    if (!e->applied && added > 0 && at >= 0) {
+        // Container: its tracks are unknown until fetched - pages are cut at `at`
+        SonosDevice* dev = getCurrentDevice();
+        int cur = dev ? dev->currentTrackNumber : 0;
+        shiftQueuePages(at, added, nullptr, nullptr);
+        if (dev && cur > at) dev->currentTrackNumber += added;
+    } else if (e->applied && (added != 1 || at != e->first)) {
+        *exact = false;
+    }
+    e->applied = true;
+    xSemaphoreGive(deviceMutex);
+    notifyUI(UPDATE_QUEUE);
+    return true;
+}
+
+// Network task: send every queued edit in order (including ones posted meanwhile),
+// then probe Q:0 once. When its child count is what the local edits predict, the new
+// UpdateID is adopted and the resident pages stand; any failure or mismatch falls
+// back to the regular refresh.
+void SonosController::processQueueEdits() {
+    uint32_t t0 = millis();
+    int sent = 0;
+    bool exact = true;
+    for (;;) {
+        QueueEdit* e = nullptr;
+        xSemaphoreTake(deviceMutex, portMAX_DELAY);
+        if (queueEditTail != queueEditHead) e = &queueEdits[queueEditTail % SONOS_QUEUE_EDIT_SLOTS];
+        xSemaphoreGive(deviceMutex);
+
+        if (e) {
+            // The slot stays owned by this task until the tail moves past it
+            bool ok = sendQueueEdit(e, &exact);
+            xSemaphoreTake(deviceMutex, portMAX_DELAY);
+            e->uri = String();
+            e->meta = String();
+            queueEditTail++;
+            if (!ok) {
+                queueEditTail = queueEditHead;  // The rest assumed this one - refetch instead
+                exact = false;
+            }
+            xSemaphoreGive(deviceMutex);
+            sent++;
+            continue;
+        }
+
+        uint32_t id = 0;
+        int childCount = -1;
+        bool probed = probeContainer("Q:0", &id, &childCount);
+        xSemaphoreTake(deviceMutex, portMAX_DELAY);
+        if (queueEditTail != queueEditHead) {
+            xSemaphoreGive(deviceMutex);
+            continue;  // More edits came in during the probe
+        }
+        SonosDevice* dev = getCurrentDevice();
+        exact = exact && probed && dev && childCount == dev->totalTracks;
+        queueUpdateID = id;
+        queueUpdateIDValid = exact;
+        queueEditBusy = false;
+        xSemaphoreGive(deviceMutex);
+        break;
+    }
+
+    Serial.printf("[QUEUE] %d edits sent in %lu ms - %s\n", sent, (unsigned long)(millis() - t0),
+                  exact ? "reconciled" : "refetching");
+    if (exact) notifyUI(UPDATE_QUEUE);
+    else updateQueue();
 }
 
 // ============================================================================
@@ -1211,6 +2114,7 @@ void SonosController::processCommand(CommandRequest_t* cmd) {
                 dev->volume = cmd->value;
                 xSemaphoreGive(deviceMutex);
             }
+            publishSnapshot();
             break;
 
         case CMD_SET_MUTE:
@@ -1222,6 +2126,7 @@ void SonosController::processCommand(CommandRequest_t* cmd) {
                 dev->isMuted = (cmd->value == 1);
                 xSemaphoreGive(deviceMutex);
             }
+            publishSnapshot();
             break;
 
         case CMD_SET_SHUFFLE: {
@@ -1271,6 +2176,37 @@ void SonosController::processCommand(CommandRequest_t* cmd) {
             break;
         }
 
+        case CMD_FETCH_QUEUE_PAGE: {
+            // Skip if another fetch loaded it meanwhile or the list scrolled far away
+            int start = cmd->value;
+            bool wanted = false;
+            if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(50))) {
+                int view = queueViewIndex;
+                wanted = !queuePageFull(start) && view >= 0 &&
+                         abs(queuePageStart(view) - start) <= SONOS_QUEUE_BATCH_SIZE;
+                xSemaphoreGive(deviceMutex);
+            }
+            if (wanted && fetchQueuePage(start)) notifyUI(UPDATE_QUEUE);
+            __atomic_fetch_and(&queuePagePending, ~(1u << (start / SONOS_QUEUE_BATCH_SIZE)), __ATOMIC_RELEASE);
+            break;
+        }
+
+        case CMD_REFRESH_QUEUE:
+            updateQueue();
+            break;
+
+        case CMD_BROWSE:
+            processBrowse(cmd->value);
+            break;
+
+        case CMD_BROWSE_JUMP:
+            buildBrowseJump();
+            break;
+
+        case CMD_QUEUE_EDIT:
+            processQueueEdits();
+            break;
+
         default:
             break;
     }
@@ -1297,6 +2233,10 @@ void SonosController::networkTaskFunction(void* param) {
         if (xQueueReceive(ctrl->commandQueue, &cmd, pdMS_TO_TICKS(20))) {
             ctrl->processCommand(&cmd);
         }
+        if (ctrl->queueEditDropPending && xSemaphoreTake(ctrl->deviceMutex, pdMS_TO_TICKS(100))) {
+            ctrl->dropQueueEdits();
+            xSemaphoreGive(ctrl->deviceMutex);
+        }
         vTaskDelay(pdMS_TO_TICKS(5));
     }
 }
@@ -1347,6 +2287,7 @@ void SonosController::pollingTaskFunction(void* param) {
             // Track info every cycle for instant updates when changing sources
             ctrl->updateTrackInfo();
             ctrl->updatePlaybackState();
+            ctrl->ensureNextQueuePage();
 
             // Detect station change and fetch station name immediately
             if (dev->isRadioStation && dev->currentURI != previousURI) {
@@ -1377,7 +2318,7 @@ void SonosController::pollingTaskFunction(void* param) {
                 ctrl->updateTransportSettings();
             }
 
-            // Queue polling - skip for radio stations
+            // Queue change probe - skip for radio stations
             if (tick % POLL_QUEUE_MODULO == 0 && !dev->isRadioStation) {
                 ctrl->updateQueue();
             }
@@ -1,11 +1,17 @@
 /**
  * UI Album Art Handling
- * Album art loading with ESP32-P4 hardware JPEG decoder + PNGdec + bilinear scaling
+ * Album art loading with ESP32-P4 hardware JPEG decoder (JPEGDEC fallback) + PNGdec + bilinear scaling
  */
 
 #include "ui_common.h"
 #include "config.h"
+#include "art_thumbs.h"
+#include "render_governor.h"
+#include "art_flash_cache.h"
+#include "art_http_cache.h"
+#include "art_url_rules.h"
 #include <PNGdec.h>
+#include <JPEGDEC.h>
 
 // ESP32-P4 Hardware JPEG Decoder
 #include "driver/jpeg_decode.h"
@@ -23,6 +29,9 @@ static uint16_t* jpeg_decode_buffer = nullptr;  // Destination for JPEG/PNG deco
 // PNG decoder instance
 static PNG png;
 
+// Software JPEG decoder instance (fallback when the HW engine rejects a file)
+static JPEGDEC jpeg;
+
 // Smooth background color transition state
 static uint32_t current_bg_color = 0x1a1a1a;
 static uint32_t target_bg_color = 0x1a1a1a;
@@ -86,7 +95,7 @@ void setBackgroundColor(uint32_t hex_color) {
     lv_anim_set_exec_cb(&anim, color_anim_cb);
     lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
     lv_anim_set_completed_cb(&anim, color_anim_done_cb);
-    lv_anim_start(&anim);
+    governorAnimStart(&anim);
 }
 
 // Sample pixels for dominant color extraction
@@ -216,88 +225,305 @@ static int pngDraw(PNGDRAW* pDraw) {
     return 1;  // Continue decoding
 }
 
-// Prepare and sanitize album art URL
-// Handles: HTML entity decoding, Sonos Radio URL extraction, size reduction, URL encoding
-static String prepareAlbumArtURL(const String& rawUrl) {
-    String fetchUrl = decodeHTMLEntities(rawUrl);
-
-    // Sonos Radio fix: extract high-quality art from embedded mark parameter
-    is_sonos_radio_art = false;  // Reset flag
-    int markIndex = fetchUrl.indexOf("mark=http");
-    if (markIndex == -1) {
-        markIndex = fetchUrl.indexOf("mark=https");
+// JPEGDEC callback - copy an MCU block into the (scaled) decode buffer
+static int jpegDraw(JPEGDRAW* pDraw) {
+    if (!jpeg_decode_buffer) return 0;
+    int w = pDraw->iWidth;  // MCU-padded block width
+    if (pDraw->x + w > jpeg_image_width) w = jpeg_image_width - pDraw->x;
+    if (w <= 0) return 1;
+
+    for (int row = 0; row < pDraw->iHeight; row++) {
+        int y = pDraw->y + row;
+        if (y >= jpeg_image_height) break;
+        memcpy(&jpeg_decode_buffer[y * jpeg_image_width + pDraw->x], &pDraw->pPixels[row * pDraw->iWidth], w * 2);
+        if (y + 1 > jpeg_output_height) jpeg_output_height = y + 1;
     }
-    if (fetchUrl.indexOf("sonosradio.imgix.net") != -1 && markIndex != -1) {
-        Serial.println("[ART] Sonos Radio art detected");
-        int markStart = markIndex + 5;  // After "mark="
-        int markEnd = fetchUrl.indexOf("&", markStart);
-        if (markEnd == -1) markEnd = fetchUrl.length();
-
-        fetchUrl = fetchUrl.substring(markStart, markEnd);
-        is_sonos_radio_art = true;
-        Serial.printf("[ART] Extracted: %s\n", fetchUrl.c_str());
+
+    // Track output dimensions
+    if (pDraw->x + w > jpeg_output_width) jpeg_output_width = pDraw->x + w;
+    return 1;  // Continue decoding
+}
+
+// Average of the sampled edge pixels, darkened for use as background color
+static uint32_t computeDominantColor() {
+    uint32_t new_color = 0x1a1a1a;  // Default dark color
+    if (color_sample_count > 0) {
+        uint8_t avg_r = color_r_sum / color_sample_count;
+        uint8_t avg_g = color_g_sum / color_sample_count;
+        uint8_t avg_b = color_b_sum / color_sample_count;
+
+        // Darken for background (multiply by 0.4)
+        avg_r = (avg_r * 4) / 10;
+        avg_g = (avg_g * 4) / 10;
+        avg_b = (avg_b * 4) / 10;
+
+        new_color = (avg_r << 16) | (avg_g << 8) | avg_b;
     }
+    return new_color;
+}
 
-    // Reduce image size for known providers to stay under size limit
-    // Deezer: 1000x1000 → 400x400
-    if (fetchUrl.indexOf("dzcdn.net") != -1) {
-        fetchUrl.replace("/1000x1000-", "/400x400-");
+// Key of the frame currently held in art_buffer (re-requests skip all I/O)
+static uint32_t shown_art_key = 0;
+
+// Thumbnail-only requests (quick-launch grid), taken when no track art is pending.
+// Such a pass fills the thumbnail and flash caches but never reaches the screen.
+static String thumb_prefetch[ART_PREFETCH_SLOTS];  // FIFO, guarded by art_mutex
+static int thumb_prefetch_count = 0;
+static bool art_thumb_only = false;                // Current pass is a prefetch (art task)
+static String thumb_saved_last_url;                // last_art_url before the prefetch pass
+
+// Copy completed image from art_temp_buffer to the display buffer and hand it to the UI
+// copy_frame=false re-shows the frame already in art_buffer
+static void publishAlbumArt(const char* url, uint32_t key, uint32_t new_color, bool copy_frame = true) {
+    if (art_thumb_only) return;  // Thumbnails are stored already - nothing to show
+    // Copy completed image from temp to display buffer atomically
+    if (copy_frame) memcpy(art_buffer, art_temp_buffer, ART_SIZE * ART_SIZE * 2);
+    shown_art_key = key;
+
+    memset(&art_dsc, 0, sizeof(art_dsc));
+    art_dsc.header.w = ART_SIZE;
+    art_dsc.header.h = ART_SIZE;
+    art_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    art_dsc.data_size = ART_SIZE * ART_SIZE * 2;
+    art_dsc.data = (const uint8_t*)art_buffer;
+
+    // Update all shared variables atomically under mutex
+    if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
+        last_art_url = url;
+        dominant_color = new_color;
+        art_ready = true;
+        color_ready = true;
+        xSemaphoreGive(art_mutex);
+        governorWake();  // Picked up by processUpdates() on the next loop pass
     }
-    // TuneIn (cdn-profiles.tunein.com): keep original size
-    // Note: logoq is 145x145, logog is 600x600 (too big for PNG decode)
-    if (fetchUrl.indexOf("cdn-profiles.tunein.com") != -1 && fetchUrl.indexOf("?d=") != -1) {
-        fetchUrl.replace("?d=1024", "?d=400");
-        fetchUrl.replace("?d=600", "?d=400");
+}
+
+// Decoder path counters: how often each path runs and what it costs
+enum ArtDecodePath {
+    DECODE_HW_JPEG = 0,
+    DECODE_SW_JPEG_FALLBACK,   // HW engine rejected the file
+    DECODE_SW_JPEG_NO_HW,      // HW engine failed to initialize
+    DECODE_PNG,
+    DECODE_PATH_COUNT
+};
+static const char* const decode_path_names[DECODE_PATH_COUNT] = {"HW JPEG", "SW JPEG (HW rejected)", "SW JPEG (no HW)", "PNG"};
+
+struct DecodeStats {
+    uint32_t ok;
+    uint32_t failed;
+    uint32_t total_ms;   // Successful decodes only (incl. scaling to ART_SIZE)
+    uint32_t max_ms;
+};
+static DecodeStats decode_stats[DECODE_PATH_COUNT];
+
+static void noteDecode(ArtDecodePath path, bool ok, uint32_t ms) {
+    DecodeStats* st = &decode_stats[path];
+    if (!ok) { st->failed++; return; }
+    st->ok++;
+    st->total_ms += ms;
+    if (ms > st->max_ms) st->max_ms = ms;
+}
+
+void artDecodeLogStats() {
+    for (int i = 0; i < DECODE_PATH_COUNT; i++) {
+        const DecodeStats* st = &decode_stats[i];
+        if (st->ok == 0 && st->failed == 0) continue;
+        Serial.printf("[ART] Decode %s: %lu ok, %lu failed, avg %lums, max %lums\n", decode_path_names[i],
+                      (unsigned long)st->ok, (unsigned long)st->failed,
+                      (unsigned long)(st->ok ? st->total_ms / st->ok : 0), (unsigned long)st->max_ms);
     }
-    // Spotify: Keep original resolution (640x640) since HTTP is lightweight
-    // No size reduction needed - HTTP has no TLS overhead!
-
-    // CRITICAL FIX: Downgrade HTTPS → HTTP for public CDN URLs
-    // Removes ALL TLS overhead (handshake, encryption, DMA memory)
-    // This is the KEY to SDIO stability - no TLS = no crashes!
-    // Public album art doesn't need encryption
-    if (fetchUrl.startsWith("https://")) {
-        // Spotify CDN
-        if (fetchUrl.indexOf("i.scdn.co") != -1 ||
-            fetchUrl.indexOf("mosaic.scdn.co") != -1) {
-            fetchUrl.replace("https://", "http://");
-        }
-        // Deezer CDN
-        else if (fetchUrl.indexOf("dzcdn.net") != -1) {
-            fetchUrl.replace("https://", "http://");
-        }
-        // TuneIn CDN
-        else if (fetchUrl.indexOf("cdn-profiles.tunein.com") != -1 ||
-                 fetchUrl.indexOf("cdn-radiotime-logos.tunein.com") != -1) {
-            fetchUrl.replace("https://", "http://");
+}
+
+// ESP32-P4 hardware JPEG decode + bilinear scale into art_temp_buffer.
+// Strips COM markers in place first (*cleaned_size is the resulting length).
+static bool hardwareJpegDecode(uint8_t* jpgBuf, size_t read, size_t* cleaned_size) {
+    Serial.printf("[ART] HW JPEG decode: %d bytes\n", (int)read);
+
+    // CRITICAL: ESP32-P4 HW decoder fails on COM markers (error 258)
+    // Strip COM markers (0xFFFE) to prevent "COM marker data underflow" errors
+    for (size_t i = 0; i < read - 1; ) {
+        if (jpgBuf[i] == 0xFF && jpgBuf[i+1] == 0xFE) {
+            // Found COM marker - get length
+            if (i + 3 < read) {
+                uint16_t len = (jpgBuf[i+2] << 8) | jpgBuf[i+3];
+                // Remove marker + length + data
+                size_t marker_total = 2 + len;
+                if (i + marker_total <= read) {
+                    memmove(&jpgBuf[i], &jpgBuf[i + marker_total], read - i - marker_total);
+                    read -= marker_total;
+                    Serial.printf("[ART] Stripped COM marker (%d bytes)\n", marker_total);
+                    continue;  // Don't increment i, check same position again
+                }
+            }
         }
-        // Add other public CDNs as needed
+        i++;
     }
+    *cleaned_size = read;
 
-    // Sonos getaa URLs can contain unescaped '?' and '&' in the u= parameter; encode them only
-    if (fetchUrl.indexOf("/getaa?") != -1) {
-        int uPos = fetchUrl.indexOf("u=");
-        if (uPos != -1) {
-            int uStart = uPos + 2;
-            int uEnd = fetchUrl.indexOf("&", uStart);
-            if (uEnd == -1) uEnd = fetchUrl.length();
-            String uValue = fetchUrl.substring(uStart, uEnd);
-            String uEncoded = "";
-            for (int i = 0; i < uValue.length(); i++) {
-                char c = uValue[i];
-                if (c == '?') {
-                    uEncoded += "%3F";
-                } else if (c == '&') {
-                    uEncoded += "%26";
-                } else {
-                    uEncoded += c;
-                }
+    // Get image dimensions from header (no hardware needed)
+    jpeg_decode_picture_info_t pic_info;
+    esp_err_t ret = jpeg_decoder_get_info(jpgBuf, *cleaned_size, &pic_info);
+    if (ret != ESP_OK) {
+        Serial.printf("[ART] JPEG header parse failed: %d\n", ret);
+        return false;
+    }
+    int w = pic_info.width;
+    int h = pic_info.height;
+
+    // Out-of-range dimensions are left to the software decoder (it scales while decoding)
+    if (w == 0 || h == 0 || w > 2048 || h > 2048) {
+        Serial.printf("[ART] JPEG %dx%d outside HW range (max 2048x2048)\n", w, h);
+        return false;
+    }
+
+    // Hardware outputs dimensions rounded to 16-pixel boundary
+    int out_w = ((w + 15) / 16) * 16;
+    int out_h = ((h + 15) / 16) * 16;
+    bool is_grayscale = (pic_info.sample_method == JPEG_DOWN_SAMPLING_GRAY);
+    Serial.printf("[ART] JPEG: %dx%d (output: %dx%d)%s\n", w, h, out_w, out_h,
+                  is_grayscale ? " [GRAYSCALE]" : "");
+
+    // Allocate DMA output buffer
+    // Grayscale: 1 byte/pixel, Color: 2 bytes/pixel (RGB565)
+    size_t bytes_per_pixel = is_grayscale ? 1 : 2;
+    size_t decoded_size = out_w * out_h * bytes_per_pixel;
+    jpeg_decode_memory_alloc_cfg_t rx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+    size_t rx_buffer_size = 0;
+    uint8_t* hw_out_buf = (uint8_t*)jpeg_alloc_decoder_mem(decoded_size, &rx_mem_cfg, &rx_buffer_size);
+    if (!hw_out_buf) {
+        Serial.printf("[ART] Failed to allocate %d bytes for HW decode\n", (int)decoded_size);
+        return false;
+    }
+
+    // Configure hardware decoder output format
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = is_grayscale ? JPEG_DECODE_OUT_FORMAT_GRAY : JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,  // Little endian
+        .conv_std = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+
+    uint32_t out_size = 0;
+    ret = jpeg_decoder_process(hw_jpeg_decoder, &decode_cfg, jpgBuf, *cleaned_size, hw_out_buf, rx_buffer_size, &out_size);
+
+    // For grayscale: convert GRAY8 to RGB565
+    if (ret == ESP_OK && is_grayscale) {
+        Serial.println("[ART] Converting grayscale to RGB565");
+        uint16_t* rgb_buf = (uint16_t*)heap_caps_malloc(out_w * out_h * 2, MALLOC_CAP_SPIRAM);
+        if (rgb_buf) {
+            int total_pixels = out_w * out_h;
+            for (int i = 0; i < total_pixels; i++) {
+                uint8_t g = hw_out_buf[i];
+                rgb_buf[i] = ((g >> 3) << 11) | ((g >> 2) << 5) | (g >> 3);
             }
-            fetchUrl = fetchUrl.substring(0, uStart) + uEncoded + fetchUrl.substring(uEnd);
+            heap_caps_free(hw_out_buf);  // Free DMA gray buffer
+            hw_out_buf = (uint8_t*)rgb_buf;  // Now points to RGB565
+        } else {
+            Serial.println("[ART] Grayscale conversion alloc failed");
+            heap_caps_free(hw_out_buf);
+            hw_out_buf = nullptr;
+            ret = ESP_FAIL;
         }
     }
 
-    return fetchUrl;
+    if (ret != ESP_OK || !hw_out_buf) {
+        Serial.printf("[ART] HW JPEG decode failed: %d\n", ret);
+        if (hw_out_buf) heap_caps_free(hw_out_buf);
+        return false;
+    }
+    Serial.printf("[ART] HW decoded: %d bytes\n", out_size);
+
+    // Scale to 420x420 using bilinear interpolation
+    memset(art_temp_buffer, 0, ART_SIZE * ART_SIZE * 2);
+    Serial.printf("[ART] Bilinear scaling %dx%d -> 420x420\n", w, h);
+    // Use actual image dimensions for scaling (not padded)
+    scaleImageBilinear((uint16_t*)hw_out_buf, out_w, out_h, art_temp_buffer, ART_SIZE, ART_SIZE);
+    Serial.println("[ART] Scaling complete");
+
+    // Free hardware buffer immediately
+    heap_caps_free(hw_out_buf);
+    return true;
+}
+
+// Software decode result: unsupported files are negative-cached, memory failures retried
+enum SwJpegResult { SW_JPEG_OK, SW_JPEG_UNSUPPORTED, SW_JPEG_NO_MEMORY };
+
+// Software JPEG decode (JPEGDEC) + bilinear scale into art_temp_buffer.
+// Uses the largest DCT scale (1/2, 1/4, 1/8) that keeps the short edge >= ART_SIZE,
+// so large images cost a fraction of a full decode. Progressive files are DC-only (1/8).
+static SwJpegResult softwareJpegDecode(uint8_t* data, size_t len) {
+    if (!jpeg.openRAM(data, (int)len, jpegDraw)) {
+        Serial.printf("[ART] SW JPEG open failed: %d\n", jpeg.getLastError());
+        return SW_JPEG_UNSUPPORTED;
+    }
+    int w = jpeg.getWidth();
+    int h = jpeg.getHeight();
+    bool progressive = (jpeg.getJPEGType() == JPEG_MODE_PROGRESSIVE);
+    if (w == 0 || h == 0 || w > 4096 || h > 4096) {
+        Serial.printf("[ART] Invalid JPEG dimensions: %dx%d (max 4096x4096)\n", w, h);
+        jpeg.close();
+        return SW_JPEG_UNSUPPORTED;
+    }
+
+    static const int scale_options[4] = {0, JPEG_SCALE_HALF, JPEG_SCALE_QUARTER, JPEG_SCALE_EIGHTH};
+    int shift = 0;
+    while (shift < 3 && (min(w, h) >> (shift + 1)) >= ART_SIZE) shift++;
+    if (progressive) shift = 3;
+    int sw = (w + (1 << shift) - 1) >> shift;
+    int sh = (h + (1 << shift) - 1) >> shift;
+
+    uint16_t* buf = (uint16_t*)heap_caps_malloc((size_t)sw * sh * 2, MALLOC_CAP_SPIRAM);
+    if (!buf) {
+        Serial.printf("[ART] Failed to allocate %d bytes for SW decode\n", sw * sh * 2);
+        jpeg.close();
+        return SW_JPEG_NO_MEMORY;
+    }
+    memset(buf, 0, (size_t)sw * sh * 2);
+
+    jpeg_decode_buffer = buf;
+    jpeg_image_width = sw;
+    jpeg_image_height = sh;
+    jpeg_output_width = 0;
+    jpeg_output_height = 0;
+    jpeg.setPixelType(RGB565_LITTLE_ENDIAN);
+    int ok = jpeg.decode(0, 0, scale_options[shift]);
+    jpeg.close();
+    jpeg_decode_buffer = nullptr;
+
+    if (!ok || jpeg_output_width == 0 || jpeg_output_height == 0) {
+        Serial.printf("[ART] SW JPEG decode failed: %d\n", jpeg.getLastError());
+        heap_caps_free(buf);
+        return SW_JPEG_UNSUPPORTED;
+    }
+    Serial.printf("[ART] SW JPEG: %dx%d%s at 1/%d -> %dx%d\n", w, h, progressive ? " [PROGRESSIVE]" : "",
+                  1 << shift, jpeg_output_width, jpeg_output_height);
+
+    // Compact rows in place if the decoder produced less than the buffer stride
+    int out_w = jpeg_output_width;
+    int out_h = jpeg_output_height;
+    if (out_w != sw) {
+        for (int y = 1; y < out_h; y++) memmove(&buf[y * out_w], &buf[y * sw], (size_t)out_w * 2);
+    }
+
+    memset(art_temp_buffer, 0, ART_SIZE * ART_SIZE * 2);
+    scaleImageBilinear(buf, out_w, out_h, art_temp_buffer, ART_SIZE, ART_SIZE);
+    heap_caps_free(buf);
+    return SW_JPEG_OK;
+}
+
+// Prepare and sanitize album art URL
+// HTML entity decoding, then the CDN rule table (Sonos Radio unwrap, size, HTTP downgrade, getaa escaping)
+static bool prepareAlbumArtURL(const String& rawUrl, char* out, size_t out_len) {
+    String decoded = decodeHTMLEntities(rawUrl);
+    uint8_t flags = 0;
+    if (artRewriteURL(decoded.c_str(), out, out_len, &flags) == 0) {
+        Serial.printf("[ART] URL too long (%d chars), skipping\n", decoded.length());
+        return false;
+    }
+    is_sonos_radio_art = (flags & ART_URL_UNWRAPPED) != 0;
+    if (is_sonos_radio_art) Serial.println("[ART] Sonos Radio art detected - using embedded mark URL");
+    return true;
 }
 
 void albumArtTask(void* param) {
@@ -325,6 +551,9 @@ void albumArtTask(void* param) {
     // Temporary buffer for decoded full-size image
     uint16_t* decoded_buffer = nullptr;
 
+    // Mount persistent art cache here rather than in setup() - first-boot format takes seconds
+    initArtFlashCache();
+
     while (1) {
         // Check if shutdown requested (for OTA update)
         if (art_shutdown_requested) {
@@ -342,23 +571,85 @@ void albumArtTask(void* param) {
 
         url[0] = '\0';  // Clear URL
         bool isStationLogo = false;  // Track if this is a station logo (PNG allowed)
+        uint32_t thumbKey = 0;       // Thumbnail cache key captured with the URL
         if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(10))) {
+            if (art_thumb_only) {
+                // Failure paths mark the prefetch URL as last_art_url - the track's art is unchanged
+                last_art_url = thumb_saved_last_url;
+                thumb_saved_last_url = String();
+                art_thumb_only = false;
+            }
             if (pending_art_url.length() > 0 && pending_art_url != last_art_url) {
                 isStationLogo = pending_is_station_logo;  // Capture flag while holding mutex
-                String fetchUrl = prepareAlbumArtURL(pending_art_url);
+                thumbKey = pending_art_thumb_key;
+                static char fetchUrl[sizeof(url)];
 
-                if (fetchUrl != last_art_url) {
-                    strncpy(url, fetchUrl.c_str(), sizeof(url) - 1);
-                    url[sizeof(url) - 1] = '\0';
+                if (!prepareAlbumArtURL(pending_art_url, fetchUrl, sizeof(fetchUrl))) {
+                    last_art_url = pending_art_url;  // Can't fit the fetch buffer - don't retry
+                } else if (last_art_url != fetchUrl) {
+                    strcpy(url, fetchUrl);
                     // New URL detected - reset failure tracking for clean start
                     consecutive_failures = 0;
                     last_failed_url[0] = '\0';
                 }
             }
+            while (url[0] == '\0' && thumb_prefetch_count > 0) {
+                String next = thumb_prefetch[0];
+                for (int i = 1; i < thumb_prefetch_count; i++) thumb_prefetch[i - 1] = thumb_prefetch[i];
+                thumb_prefetch[--thumb_prefetch_count] = String();
+                uint32_t key = artThumbKey(next.c_str());
+                const lv_image_dsc_t* have = artThumbAcquire(key, ART_THUMB_120);
+                if (have) {
+                    artThumbRelease(have);  // Decoded meanwhile
+                    continue;
+                }
+                if (!prepareAlbumArtURL(next, url, sizeof(url))) continue;
+                thumbKey = key;
+                isStationLogo = true;  // Favorites are often stations - PNG logos allowed
+                art_thumb_only = true;
+                thumb_saved_last_url = last_art_url;
+            }
             xSemaphoreGive(art_mutex);
         }
         if (url[0] != '\0') {
             Serial.printf("[ART] URL: %s\n", url);
+            uint32_t load_start_ms = millis();
+            bool flash_store_pending = false;
+            uint32_t flash_store_color = 0;
+
+            // Negative cache: this URL failed permanently not long ago - don't refetch
+            ArtNegReason neg = artNegLookup(thumbKey);
+            if (neg != ART_NEG_NONE) {
+                Serial.printf("[ART] Skipping URL (%s, negative-cached)\n", artNegReasonName(neg));
+                if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
+                    last_art_url = url;
+                    xSemaphoreGive(art_mutex);
+                }
+                continue;
+            }
+
+            // Local copy: frame still in art_buffer (URI changed, same art), else persistent cache.
+            // Either skips network and decoder entirely unless the validators are due for a recheck.
+            bool have_local = false;
+            uint32_t cached_color = 0;
+            if (thumbKey != 0 && thumbKey == shown_art_key) {
+                publishAlbumArt(url, thumbKey, dominant_color, false);
+                have_local = true;
+            } else if (artFlashLoad(thumbKey, art_temp_buffer, &cached_color)) {
+                artThumbStore(thumbKey, art_temp_buffer);
+                publishAlbumArt(url, thumbKey, cached_color);
+                have_local = true;
+            }
+            bool revalidating = false;
+            bool conditional = false;  // Revalidation sent validators (else a plain GET)
+            if (have_local) {
+                consecutive_failures = 0;
+                last_failed_url[0] = '\0';
+                // Thumbnail prefetches trust the flash copy - the track's own pass revalidates
+                if (art_thumb_only || !artHttpNeedsRevalidate(thumbKey)) continue;
+                Serial.println("[ART] Revalidating cached art");
+                revalidating = true;
+            }
 
             // Simple WiFi check - don't try to download if not connected
             if (WiFi.status() != WL_CONNECTED) {
@@ -456,10 +747,31 @@ void albumArtTask(void* param) {
                     // Internet: 10s timeout (CDN/remote servers can be slow)
                     http.setTimeout(isFromSonosDevice ? 3000 : 10000);
 
+                    // Validators for the next revalidation; send ours when rechecking a cached frame
+                    const char* validator_headers[] = {"ETag", "Last-Modified"};
+                    http.collectHeaders(validator_headers, 2);
+                    if (revalidating) {
+                        String etag, last_modified;
+                        if (artHttpGetValidators(thumbKey, etag, last_modified)) {
+                            if (etag.length() > 0) http.addHeader("If-None-Match", etag);
+                            if (last_modified.length() > 0) http.addHeader("If-Modified-Since", last_modified);
+                            conditional = true;
+                        }
+                    }
+
                     int code = http.GET();
                     // Keep mutex locked for entire download
 
                     if (code == 200) {
+                artHttpStoreValidators(thumbKey, http.header("ETag"), http.header("Last-Modified"));
+                if (revalidating) {
+                    // Art changed behind the same URL (or no validators to ask with) - drop
+                    // stale copies before the new decode
+                    Serial.println(conditional ? "[ART] Cached art changed on server, replacing"
+                                               : "[ART] No validators for cached art, refreshed it");
+                    artFlashInvalidate(thumbKey);
+                    artThumbInvalidate(thumbKey);
+                }
                 int len = http.getSize();
                 const size_t max_art_size = MAX_ART_SIZE;
                 const bool len_known = (len > 0);
@@ -543,10 +855,12 @@ void albumArtTask(void* param) {
 
                         if (!len_known && bytesRead >= max_art_size) {
                             Serial.println("[ART] Album art too large (max 280KB)");
+                            artNegStore(thumbKey, ART_NEG_OVERSIZE);
                             readSuccess = false;
                         }
 
                         Serial.printf("[ART] Album art read: %d bytes (len_known=%d)\n", (int)bytesRead, len_known ? 1 : 0);
+                        artHttpNoteBytes(bytesRead);
 
                         // If download failed/aborted, close connection and free TLS/DMA resources
                         if (!readSuccess) {
@@ -604,6 +918,7 @@ void albumArtTask(void* param) {
                             // Detect image format by magic bytes
                             bool isJPEG = (read >= 3 && jpgBuf[0] == 0xFF && jpgBuf[1] == 0xD8 && jpgBuf[2] == 0xFF);
                             bool isPNG = (read >= 4 && jpgBuf[0] == 0x89 && jpgBuf[1] == 0x50 && jpgBuf[2] == 0x4E && jpgBuf[3] == 0x47);
+                            uint32_t decode_start_ms = millis();
 
                             // Only decode PNG for radio station logos (not regular album art)
                             if (isPNG && isStationLogo) {
@@ -619,6 +934,7 @@ void albumArtTask(void* param) {
                                     if (w == 0 || h == 0 || w > 2048 || h > 2048 ||
                                         (size_t)w * (size_t)h * 2 > 10*1024*1024) {
                                         Serial.printf("[ART] Invalid PNG dimensions: %dx%d (max 2048x2048, 10MB)\n", w, h);
+                                        artNegStore(thumbKey, ART_NEG_UNSUPPORTED);
                                         png.close();
                                         if (decoded_buffer) { heap_caps_free(decoded_buffer); decoded_buffer = nullptr; }
                                         heap_caps_free(jpgBuf);
@@ -696,250 +1012,115 @@ void albumArtTask(void* param) {
                                             // Free decoded buffer immediately - don't hold 800KB until next image
                                             heap_caps_free(decoded_buffer);
                                             decoded_buffer = nullptr;
+                                            noteDecode(DECODE_PNG, true, millis() - decode_start_ms);
+
+                                            // Emit 120/60 mip levels into the shared thumbnail cache
+                                            artThumbStore(thumbKey, art_temp_buffer);
 
                                             // Sample dominant color from scaled image
                                             sampleDominantColor(art_temp_buffer, ART_SIZE, ART_SIZE);
 
-                                            // Calculate dominant color
-                                            uint32_t new_color = 0x1a1a1a;  // Default dark color
-                                            if (color_sample_count > 0) {
-                                                uint8_t avg_r = color_r_sum / color_sample_count;
-                                                uint8_t avg_g = color_g_sum / color_sample_count;
-                                                uint8_t avg_b = color_b_sum / color_sample_count;
+                                            uint32_t new_color = computeDominantColor();
+                                            publishAlbumArt(url, thumbKey, new_color);
 
-                                                // Darken for background (multiply by 0.4)
-                                                avg_r = (avg_r * 4) / 10;
-                                                avg_g = (avg_g * 4) / 10;
-                                                avg_b = (avg_b * 4) / 10;
-
-                                                new_color = (avg_r << 16) | (avg_g << 8) | avg_b;
-                                            }
-
-                                            // Copy completed image from temp to display buffer atomically
-                                            memcpy(art_buffer, art_temp_buffer, ART_SIZE * ART_SIZE * 2);
-
-                                            memset(&art_dsc, 0, sizeof(art_dsc));
-                                            art_dsc.header.w = ART_SIZE;
-                                            art_dsc.header.h = ART_SIZE;
-                                            art_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
-                                            art_dsc.data_size = ART_SIZE * ART_SIZE * 2;
-                                            art_dsc.data = (const uint8_t*)art_buffer;
-
-                                            // Update all shared variables atomically under mutex
-                                            if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
-                                                last_art_url = url;
-                                                dominant_color = new_color;
-                                                art_ready = true;
-                                                color_ready = true;
-                                                xSemaphoreGive(art_mutex);
-                                            }
+                                            // Persist after the network mutex is released (flash writes are slow)
+                                            artFlashNoteNetworkLoad(millis() - load_start_ms);
+                                            flash_store_pending = true;
+                                            flash_store_color = new_color;
                                             // Reset failure counter on success
                                             consecutive_failures = 0;
                                             last_failed_url[0] = '\0';
                                         }
                                     } else {
                                         Serial.printf("[ART] Failed to allocate %d bytes for decoded image\n", (int)decoded_size);
+                                        noteDecode(DECODE_PNG, false, 0);
                                     }
                                 } else {
                                     Serial.printf("[ART] PNG openRAM failed - error code: %d\n", pngResult);
+                                    noteDecode(DECODE_PNG, false, 0);
                                 }
                             } else if (isPNG && !isStationLogo) {
                                 // PNG detected but not a station logo - skip (only JPEG for normal album art)
                                 Serial.println("[ART] PNG detected but not station logo - skipping");
+                                artNegStore(thumbKey, ART_NEG_UNSUPPORTED);
                                 // Mark as done to prevent infinite retry loop
                                 if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
                                     last_art_url = url;
                                     xSemaphoreGive(art_mutex);
                                 }
-                            } else if (isJPEG && hw_jpeg_decoder) {
-                                // ESP32-P4 Hardware JPEG Decoder - fast and stable!
-                                Serial.printf("[ART] HW JPEG decode: %d bytes\n", read);
-
-                                // CRITICAL: ESP32-P4 HW decoder fails on COM markers (error 258)
-                                // Strip COM markers (0xFFFE) to prevent "COM marker data underflow" errors
+                            } else if (isJPEG) {
+                                bool decoded = false;
+                                ArtDecodePath path = hw_jpeg_decoder ? DECODE_SW_JPEG_FALLBACK : DECODE_SW_JPEG_NO_HW;
                                 size_t cleaned_size = read;
-                                for (size_t i = 0; i < read - 1; ) {
-                                    if (jpgBuf[i] == 0xFF && jpgBuf[i+1] == 0xFE) {
-                                        // Found COM marker - get length
-                                        if (i + 3 < read) {
-                                            uint16_t len = (jpgBuf[i+2] << 8) | jpgBuf[i+3];
-                                            // Remove marker + length + data
-                                            size_t marker_total = 2 + len;
-                                            if (i + marker_total <= read) {
-                                                memmove(&jpgBuf[i], &jpgBuf[i + marker_total], read - i - marker_total);
-                                                cleaned_size -= marker_total;
-                                                Serial.printf("[ART] Stripped COM marker (%d bytes)\n", marker_total);
-                                                continue;  // Don't increment i, check same position again
-                                            }
-                                        }
-                                    }
-                                    i++;
-                                }
 
-                                // Get image dimensions from header (no hardware needed)
-                                jpeg_decode_picture_info_t pic_info;
-                                esp_err_t ret = jpeg_decoder_get_info(jpgBuf, cleaned_size, &pic_info);
-                                if (ret == ESP_OK) {
-                                    int w = pic_info.width;
-                                    int h = pic_info.height;
+                                if (hw_jpeg_decoder) {
+                                    decoded = hardwareJpegDecode(jpgBuf, read, &cleaned_size);
+                                    if (decoded) path = DECODE_HW_JPEG;
+                                    else noteDecode(DECODE_HW_JPEG, false, millis() - decode_start_ms);
+                                }
 
-                                    // Validate JPEG dimensions to prevent crashes/overflow from malformed files
-                                    if (w == 0 || h == 0 || w > 2048 || h > 2048) {
-                                        Serial.printf("[ART] Invalid JPEG dimensions: %dx%d (max 2048x2048)\n", w, h);
-                                        heap_caps_free(jpgBuf);
-                                        jpgBuf = nullptr;
-                                        http.end();
-                                        if (use_https) secure_client.stop();
-                                        vTaskDelay(pdMS_TO_TICKS(200));
-                                        last_network_end_ms = millis();
-                                        if (use_https) last_https_end_ms = millis();
-                                        xSemaphoreGive(network_mutex);
-                                        mutex_acquired = false;
-                                        continue;
+                                // Software fallback: HW rejected the file (progressive, unusual subsampling,
+                                // markers) or the HW engine failed to initialize
+                                SwJpegResult sw_result = SW_JPEG_OK;
+                                if (!decoded) {
+                                    decode_start_ms = millis();
+                                    sw_result = softwareJpegDecode(jpgBuf, cleaned_size);
+                                    decoded = (sw_result == SW_JPEG_OK);
+                                }
+                                noteDecode(path, decoded, millis() - decode_start_ms);
+
+                                if (decoded) {
+                                    // Emit 120/60 mip levels into the shared thumbnail cache
+                                    artThumbStore(thumbKey, art_temp_buffer);
+
+                                    // Sample dominant color from scaled image
+                                    sampleDominantColor(art_temp_buffer, ART_SIZE, ART_SIZE);
+
+                                    uint32_t new_color = computeDominantColor();
+                                    publishAlbumArt(url, thumbKey, new_color);
+
+                                    // Persist after the network mutex is released (flash writes are slow)
+                                    artFlashNoteNetworkLoad(millis() - load_start_ms);
+                                    flash_store_pending = true;
+                                    flash_store_color = new_color;
+                                    // Reset failure counter on success
+                                    consecutive_failures = 0;
+                                    last_failed_url[0] = '\0';
+                                } else if (sw_result == SW_JPEG_UNSUPPORTED) {
+                                    // Both decoders rejected these exact bytes - a retry would download them again
+                                    artNegStore(thumbKey, ART_NEG_UNSUPPORTED);
+                                    if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
+                                        last_art_url = url;
+                                        xSemaphoreGive(art_mutex);
                                     }
-
-                                    // Hardware outputs dimensions rounded to 16-pixel boundary
-                                    int out_w = ((w + 15) / 16) * 16;
-                                    int out_h = ((h + 15) / 16) * 16;
-                                    bool is_grayscale = (pic_info.sample_method == JPEG_DOWN_SAMPLING_GRAY);
-                                    Serial.printf("[ART] JPEG: %dx%d (output: %dx%d)%s\n", w, h, out_w, out_h,
-                                                  is_grayscale ? " [GRAYSCALE]" : "");
-
-                                    // Allocate DMA output buffer
-                                    // Grayscale: 1 byte/pixel, Color: 2 bytes/pixel (RGB565)
-                                    size_t bytes_per_pixel = is_grayscale ? 1 : 2;
-                                    size_t decoded_size = out_w * out_h * bytes_per_pixel;
-                                    jpeg_decode_memory_alloc_cfg_t rx_mem_cfg = {
-                                        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
-                                    };
-                                    size_t rx_buffer_size = 0;
-                                    uint8_t* hw_out_buf = (uint8_t*)jpeg_alloc_decoder_mem(decoded_size, &rx_mem_cfg, &rx_buffer_size);
-
-                                    if (hw_out_buf) {
-                                        // Configure hardware decoder output format
-                                        jpeg_decode_cfg_t decode_cfg = {
-                                            .output_format = is_grayscale ? JPEG_DECODE_OUT_FORMAT_GRAY : JPEG_DECODE_OUT_FORMAT_RGB565,
-                                            .rgb_order = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,  // Little endian
-                                            .conv_std = JPEG_YUV_RGB_CONV_STD_BT601,
-                                        };
-
-                                        uint32_t out_size = 0;
-                                        ret = jpeg_decoder_process(hw_jpeg_decoder, &decode_cfg, jpgBuf, cleaned_size, hw_out_buf, rx_buffer_size, &out_size);
-
-                                        // For grayscale: convert GRAY8 to RGB565
-                                        if (ret == ESP_OK && is_grayscale) {
-                                            Serial.println("[ART] Converting grayscale to RGB565");
-                                            uint16_t* rgb_buf = (uint16_t*)heap_caps_malloc(out_w * out_h * 2, MALLOC_CAP_SPIRAM);
-                                            if (rgb_buf) {
-                                                int total_pixels = out_w * out_h;
-                                                for (int i = 0; i < total_pixels; i++) {
-                                                    uint8_t g = hw_out_buf[i];
-                                                    rgb_buf[i] = ((g >> 3) << 11) | ((g >> 2) << 5) | (g >> 3);
-                                                }
-                                                heap_caps_free(hw_out_buf);  // Free DMA gray buffer
-                                                hw_out_buf = (uint8_t*)rgb_buf;  // Now points to RGB565
-                                            } else {
-                                                Serial.println("[ART] Grayscale conversion alloc failed");
-                                                heap_caps_free(hw_out_buf);
-                                                hw_out_buf = nullptr;
-                                                ret = ESP_FAIL;
-                                            }
-                                        }
-
-                                        if (ret == ESP_OK && hw_out_buf) {
-                                            Serial.printf("[ART] HW decoded: %d bytes\n", out_size);
-
-                                            // Scale to 420x420 using bilinear interpolation
-                                            memset(art_temp_buffer, 0, ART_SIZE * ART_SIZE * 2);
-                                            Serial.printf("[ART] Bilinear scaling %dx%d -> 420x420\n", w, h);
-                                            // Use actual image dimensions for scaling (not padded)
-                                            scaleImageBilinear((uint16_t*)hw_out_buf, out_w, out_h, art_temp_buffer, ART_SIZE, ART_SIZE);
-                                            Serial.println("[ART] Scaling complete");
-
-                                            // Free hardware buffer immediately
-                                            heap_caps_free(hw_out_buf);
-                                            hw_out_buf = nullptr;
-
-                                            // Sample dominant color from scaled image
-                                            sampleDominantColor(art_temp_buffer, ART_SIZE, ART_SIZE);
-
-                                            // Calculate dominant color
-                                            uint32_t new_color = 0x1a1a1a;  // Default dark color
-                                            if (color_sample_count > 0) {
-                                                uint8_t avg_r = color_r_sum / color_sample_count;
-                                                uint8_t avg_g = color_g_sum / color_sample_count;
-                                                uint8_t avg_b = color_b_sum / color_sample_count;
-
-                                                // Darken for background (multiply by 0.4)
-                                                avg_r = (avg_r * 4) / 10;
-                                                avg_g = (avg_g * 4) / 10;
-                                                avg_b = (avg_b * 4) / 10;
-
-                                                new_color = (avg_r << 16) | (avg_g << 8) | avg_b;
-                                            }
-
-                                            // Copy completed image from temp to display buffer atomically
-                                            memcpy(art_buffer, art_temp_buffer, ART_SIZE * ART_SIZE * 2);
-
-                                            memset(&art_dsc, 0, sizeof(art_dsc));
-                                            art_dsc.header.w = ART_SIZE;
-                                            art_dsc.header.h = ART_SIZE;
-                                            art_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
-                                            art_dsc.data_size = ART_SIZE * ART_SIZE * 2;
-                                            art_dsc.data = (const uint8_t*)art_buffer;
-
-                                            // Update all shared variables atomically under mutex
-                                            if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
-                                                last_art_url = url;
-                                                dominant_color = new_color;
-                                                art_ready = true;
-                                                color_ready = true;
-                                                xSemaphoreGive(art_mutex);
-                                            }
-                                            // Reset failure counter on success
-                                            consecutive_failures = 0;
-                                            last_failed_url[0] = '\0';
-                                        } else {
-                                            Serial.printf("[ART] HW JPEG decode failed: %d\n", ret);
-                                            if (hw_out_buf) heap_caps_free(hw_out_buf);
-                                            // Track decode failures to prevent infinite retry
-                                            if (strcmp(url, last_failed_url) == 0) {
-                                                consecutive_failures++;
-                                            } else {
-                                                strncpy(last_failed_url, url, sizeof(last_failed_url) - 1);
-                                                last_failed_url[sizeof(last_failed_url) - 1] = '\0';
-                                                consecutive_failures = 1;
-                                            }
-                                            // Exponential backoff: 200ms, 400ms, 600ms... (prevents rapid retry hammering)
-                                            if (consecutive_failures > 1) {
-                                                vTaskDelay(pdMS_TO_TICKS(consecutive_failures * 200));
-                                            }
-                                            if (consecutive_failures >= 3) {
-                                                Serial.printf("[ART] Decode failed %d times, skipping URL\n", consecutive_failures);
-                                                if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
-                                                    last_art_url = url;
-                                                    xSemaphoreGive(art_mutex);
-                                                }
-                                                consecutive_failures = 0;
-                                                last_failed_url[0] = '\0';
-                                            }
-                                        }
+                                    consecutive_failures = 0;
+                                    last_failed_url[0] = '\0';
+                                } else {
+                                    // Out of memory - may clear up, retry with backoff
+                                    if (strcmp(url, last_failed_url) == 0) {
+                                        consecutive_failures++;
                                     } else {
-                                        Serial.printf("[ART] Failed to allocate %d bytes for HW decode\n", (int)decoded_size);
+                                        strncpy(last_failed_url, url, sizeof(last_failed_url) - 1);
+                                        last_failed_url[sizeof(last_failed_url) - 1] = '\0';
+                                        consecutive_failures = 1;
+                                    }
+                                    // Exponential backoff: 200ms, 400ms, 600ms... (prevents rapid retry hammering)
+                                    if (consecutive_failures > 1) {
+                                        vTaskDelay(pdMS_TO_TICKS(consecutive_failures * 200));
+                                    }
+                                    if (consecutive_failures >= 3) {
+                                        Serial.printf("[ART] Decode failed %d times, skipping URL\n", consecutive_failures);
+                                        if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
+                                            last_art_url = url;
+                                            xSemaphoreGive(art_mutex);
+                                        }
+                                        consecutive_failures = 0;
+                                        last_failed_url[0] = '\0';
                                     }
-                                } else {
-                                    Serial.printf("[ART] JPEG header parse failed: %d\n", ret);
-                                }
-                            } else if (isJPEG) {
-                                // Fallback: Software JPEG decode (if hardware not available)
-                                Serial.println("[ART] HW JPEG unavailable, skipping");
-                                // Mark as done to prevent retry
-                                if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
-                                    last_art_url = url;
-                                    xSemaphoreGive(art_mutex);
                                 }
                             } else {
                                 Serial.println("[ART] Unknown image format (not JPEG or PNG)");
+                                artNegStore(thumbKey, ART_NEG_UNSUPPORTED);
                                 // Mark as done to prevent retry loop
                                 if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
                                     last_art_url = url;
@@ -958,6 +1139,7 @@ void albumArtTask(void* param) {
                     }
                 } else if (len >= (int)max_art_size) {
                     Serial.printf("[ART] Album art too large: %d bytes (max %dKB)\n", len, (int)(max_art_size/1000));
+                    artNegStore(thumbKey, ART_NEG_OVERSIZE);
                     // Force close - don't drain (overwhelms SDIO buffer)
                     WiFiClient* stream = http.getStreamPtr();
                     stream->stop();
@@ -979,6 +1161,18 @@ void albumArtTask(void* param) {
                     } else {
                         Serial.printf("[ART] Invalid album art size: %d bytes\n", len);
                     }
+                    } else if (code == 304 && revalidating) {
+                        // Cached frame (already on screen) is still current
+                        Serial.println("[ART] 304 Not Modified");
+                        artHttpMarkValidated(thumbKey);
+                    } else if (code == 404 || code == 410) {
+                        // Art is gone - retrying won't help until the TTL expires
+                        Serial.printf("[ART] HTTP %d: Not found\n", code);
+                        artNegStore(thumbKey, ART_NEG_NOT_FOUND);
+                        if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(100))) {
+                            last_art_url = url;
+                            xSemaphoreGive(art_mutex);
+                        }
                     } else {
                         // Translate HTTP error codes to human-readable messages
                         const char* error_msg = "Unknown error";
@@ -1045,6 +1239,11 @@ void albumArtTask(void* param) {
                 }
 
             } // http and secure_client destructors - no-op since already stopped
+
+            // art_temp_buffer still holds the published frame (network mutex released by now)
+            if (flash_store_pending) {
+                artFlashStore(thumbKey, art_temp_buffer, flash_store_color);
+            }
         }
         vTaskDelay(pdMS_TO_TICKS(100));  // Check for new URLs
     }
@@ -1070,10 +1269,21 @@ String urlEncode(const char* url) {
     return String(encoded);
 }
 
-void requestAlbumArt(const String& url) {
-    if (url.length() == 0) return;
-    if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(10))) {
-        pending_art_url = url;
-        xSemaphoreGive(art_mutex);
-    }
+bool requestArtThumb(const String& url) {
+    if (url.length() == 0) return true;
+    if (!xSemaphoreTake(art_mutex, pdMS_TO_TICKS(10))) return false;  // Caller retries
+    bool queued = false;
+    for (int i = 0; i < thumb_prefetch_count && !queued; i++) queued = thumb_prefetch[i] == url;
+    if (!queued && thumb_prefetch_count < ART_PREFETCH_SLOTS) thumb_prefetch[thumb_prefetch_count++] = url;
+    xSemaphoreGive(art_mutex);
+    return true;
+}
+
+bool requestAlbumArt(const String& url, uint32_t thumbKey) {
+    if (url.length() == 0) return true;
+    if (!xSemaphoreTake(art_mutex, pdMS_TO_TICKS(10))) return false;  // Caller retries
+    pending_art_url = url;
+    pending_art_thumb_key = thumbKey ? thumbKey : artThumbKey(url.c_str());
+    xSemaphoreGive(art_mutex);
+    return true;
 }
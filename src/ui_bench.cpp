@@ -0,0 +1,321 @@
+/**
+ * UI Bench
+ * Layout cost = lv_obj_update_layout() after marking the whole screen dirty; render
+ * cost = lv_snapshot_take() into an offscreen RGB565 buffer (no flush/rotate, see the
+ * frame profiler for those). Scripted steps also time processUpdates() (change-set
+ * drain + per-widget apply) and a live refresh. The queue and browse screens render
+ * pages injected into the controller's caches, not the speaker's.
+ */
+
+#include "ui_bench.h"
+#include "ui_common.h"
+#include "lyrics.h"
+#include "alloc_trace.h"
+#include <esp_task_wdt.h>
+
+#define BENCH_MAX_CREATE 16
+
+struct CreateTiming {
+    const char* screen;
+    uint32_t us;
+};
+static CreateTiming create_timings[BENCH_MAX_CREATE];
+static int create_count = 0;
+
+void uiBenchNoteCreate(const char* screen, uint32_t us) {
+    if (create_count < BENCH_MAX_CREATE) create_timings[create_count++] = {screen, us};
+}
+
+static uint32_t createTime(const char* screen) {
+    for (int i = 0; i < create_count; i++) {
+        if (strcmp(create_timings[i].screen, screen) == 0) return create_timings[i].us;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Snapshot output
+// ============================================================================
+static const char b64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct B64Writer {
+    uint8_t in[3];
+    int n;
+    char line[77];
+    int col;
+};
+
+static void b64Flush(B64Writer* w) {
+    if (w->col == 0) return;
+    w->line[w->col] = '\0';
+    Serial.println(w->line);
+    w->col = 0;
+}
+
+static void b64Emit(B64Writer* w, int count) {
+    uint32_t v = (w->in[0] << 16) | (w->in[1] << 8) | w->in[2];
+    w->line[w->col++] = b64_chars[(v >> 18) & 0x3F];
+    w->line[w->col++] = b64_chars[(v >> 12) & 0x3F];
+    w->line[w->col++] = count > 1 ? b64_chars[(v >> 6) & 0x3F] : '=';
+    w->line[w->col++] = count > 2 ? b64_chars[v & 0x3F] : '=';
+    if (w->col >= 76) b64Flush(w);
+}
+
+static void b64Write(B64Writer* w, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        w->in[w->n++] = data[i];
+        if (w->n == 3) {
+            b64Emit(w, 3);
+            w->n = 0;
+        }
+    }
+}
+
+static void b64Finish(B64Writer* w) {
+    if (w->n > 0) {
+        for (int i = w->n; i < 3; i++) w->in[i] = 0;
+        b64Emit(w, w->n);
+        w->n = 0;
+    }
+    b64Flush(w);
+}
+
+static void put16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+static void put32(uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+
+// 16-bit BI_BITFIELDS BMP (RGB565 rows as-is, bottom-up)
+static void dumpBMP(const char* name, const lv_draw_buf_t* buf) {
+    uint32_t w = buf->header.w, h = buf->header.h;
+    uint32_t row_bytes = (w * 2 + 3) & ~3u;
+    uint8_t hdr[66] = {0};
+    hdr[0] = 'B'; hdr[1] = 'M';
+    put32(hdr + 2, sizeof(hdr) + row_bytes * h);
+    put32(hdr + 10, sizeof(hdr));
+    put32(hdr + 14, 40);
+    put32(hdr + 18, w);
+    put32(hdr + 22, h);
+    put16(hdr + 26, 1);
+    put16(hdr + 28, 16);
+    put32(hdr + 30, 3);              // BI_BITFIELDS
+    put32(hdr + 34, row_bytes * h);
+    put32(hdr + 54, 0xF800);         // R mask
+    put32(hdr + 58, 0x07E0);         // G mask
+    put32(hdr + 62, 0x001F);         // B mask
+
+    B64Writer bw = {};
+    Serial.printf("-----BEGIN %s.bmp-----\n", name);
+    b64Write(&bw, hdr, sizeof(hdr));
+    static const uint8_t pad[4] = {0};
+    for (int32_t y = h - 1; y >= 0; y--) {
+        b64Write(&bw, buf->data + y * buf->header.stride, w * 2);
+        b64Write(&bw, pad, row_bytes - w * 2);
+        if ((y & 63) == 0) esp_task_wdt_reset();
+    }
+    b64Finish(&bw);
+    Serial.println("-----END-----");
+}
+
+// FNV-1a over the visible pixels (stride padding excluded)
+static uint32_t hashPixels(const lv_draw_buf_t* buf) {
+    uint32_t h = 2166136261u;
+    for (uint32_t y = 0; y < buf->header.h; y++) {
+        const uint8_t* row = buf->data + y * buf->header.stride;
+        for (uint32_t x = 0; x < (uint32_t)buf->header.w * 2; x++) {
+            h ^= row[x];
+            h *= 16777619u;
+        }
+    }
+    return h;
+}
+
+static void benchScreen(const char* name, lv_obj_t* scr, bool dump) {
+    if (!scr) return;
+    uint32_t t0 = micros();
+    lv_obj_mark_layout_as_dirty(scr);
+    lv_obj_update_layout(scr);
+    uint32_t layout_us = micros() - t0;
+
+    t0 = micros();
+    lv_draw_buf_t* snap = lv_snapshot_take(scr, LV_COLOR_FORMAT_RGB565);
+    uint32_t render_us = micros() - t0;
+    if (!snap) {
+        Serial.printf("%s,%lu,%lu,-,snapshot failed\n", name, (unsigned long)createTime(name),
+                      (unsigned long)layout_us);
+        return;
+    }
+    Serial.printf("%s,%lu,%lu,%lu,%08lx\n", name, (unsigned long)createTime(name),
+                  (unsigned long)layout_us, (unsigned long)render_us, (unsigned long)hashPixels(snap));
+    if (dump) dumpBMP(name, snap);
+    lv_draw_buf_destroy(snap);
+    esp_task_wdt_reset();
+}
+
+// ============================================================================
+// Scripted state
+// ============================================================================
+struct BenchStep {
+    const char* name;
+    const char* title;
+    const char* artist;
+    const char* album;
+    const char* uri;
+    int track;        // Queue position (1-based)
+    int pos;          // Seconds
+    int dur;
+    bool playing;
+    int volume;
+    bool radio;
+};
+
+static const BenchStep steps[] = {
+    {"track",      "Harvest Moon", "Neil Young", "Harvest Moon", "x-sonos-vli:bench-1", 1, 15, 301, true, 30, false},
+    {"position",   "Harvest Moon", "Neil Young", "Harvest Moon", "x-sonos-vli:bench-1", 1, 16, 301, true, 30, false},
+    {"volume",     "Harvest Moon", "Neil Young", "Harvest Moon", "x-sonos-vli:bench-1", 1, 17, 301, true, 45, false},
+    {"pause",      "Harvest Moon", "Neil Young", "Harvest Moon", "x-sonos-vli:bench-1", 1, 17, 301, false, 45, false},
+    {"next_track", "Unknown Legend", "Neil Young", "Harvest Moon", "x-sonos-vli:bench-2", 2, 0, 192, true, 45, false},
+    {"long_title", "A Very Long Track Title That Has To Be Truncated By The Label (Remastered Deluxe Edition)",
+                   "Someone Featuring Someone Else And Friends", "The Complete Anthology Vol. 1",
+                   "x-sonos-vli:bench-3", 3, 42, 640, true, 45, false},
+    {"radio",      "Evening Jazz", "", "", "x-sonosapi-stream:bench", 0, 0, 0, true, 45, true},
+};
+
+static void applyStep(SonosDevice* d, const BenchStep* s) {
+    char buf[16];
+    d->connected = true;
+    d->currentTrack = s->title;
+    d->currentArtist = s->artist;
+    d->currentAlbum = s->album;
+    d->currentURI = s->uri;
+    d->albumArtURL = "";           // Keep the art task (and the network) out of the measurement
+    d->radioStationArtURL = "";
+    d->isRadioStation = s->radio;
+    d->radioStationName = s->radio ? s->title : "";
+    d->currentTrackNumber = s->track;
+    d->relTimeSeconds = s->pos;
+    d->durationSeconds = s->dur;
+    snprintf(buf, sizeof(buf), "0:%02d:%02d", s->pos / 60, s->pos % 60);
+    d->relTime = buf;
+    snprintf(buf, sizeof(buf), "0:%02d:%02d", s->dur / 60, s->dur % 60);
+    d->trackDuration = buf;
+    d->isPlaying = s->playing;
+    d->volume = s->volume;
+}
+
+static void fillQueueItem(int index, QueueItemView* q) {
+    snprintf(q->title, sizeof(q->title), "Bench Track %d", index + 1);
+    strlcpy(q->artist, (index % 10 == 0) ? "Various Artists" : "Neil Young", sizeof(q->artist));
+}
+
+// First page of a 300-track queue (rows past it show the loading placeholder)
+static void fillQueue() {
+    sonos.injectQueuePage(0, SONOS_QUEUE_BATCH_SIZE, 300, fillQueueItem);
+}
+
+// Folder ID no speaker uses - the page just ages out of the browse cache afterwards
+#define BENCH_BROWSE_ID "BENCH:"
+
+static bool fillBrowseItem(int index, char* title, size_t len) {
+    bool folder = index % 4 == 0;
+    snprintf(title, len, folder ? "Bench Folder %d" : "Bench Album %d", index + 1);
+    return folder;
+}
+
+// One full page, so the browse screen binds every row without requesting more
+// (and the folder stays under BROWSE_JUMP_MIN_ITEMS - no jump index sampling)
+static void fillBrowse() {
+    sonos.injectBrowsePage(BENCH_BROWSE_ID, 0, BROWSE_PAGE_SIZE, BROWSE_PAGE_SIZE, fillBrowseItem);
+    current_browse_id = BENCH_BROWSE_ID;
+    current_browse_title = "Bench Library";
+    createBrowseScreen();
+}
+
+static void benchSteps(SonosDevice* d) {
+    Serial.println("step,update_us,allocs,refresh_us");
+    lv_screen_load(scr_main);
+    lv_refr_now(NULL);
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        applyStep(d, &steps[i]);
+        sonos.publishSnapshot();
+        uint32_t t0 = micros();
+        processUpdates();
+        uint32_t update_us = micros() - t0;
+        t0 = micros();
+        lv_refr_now(NULL);
+        uint32_t refresh_us = micros() - t0;
+        char allocs[12] = "-";  // Needs UI_ALLOC_TRACE
+        if (allocTraceEnabled()) snprintf(allocs, sizeof(allocs), "%lu", (unsigned long)uiUpdateLastAllocs());
+        Serial.printf("%s,%lu,%s,%lu\n", steps[i].name, (unsigned long)update_us, allocs, (unsigned long)refresh_us);
+        esp_task_wdt_reset();
+    }
+}
+
+void uiBenchRun(bool dump_snapshots) {
+    Serial.println("[BENCH] Pausing Sonos tasks");
+    bool had_tasks = sonos.getPollingTaskHandle() != NULL;
+    if (had_tasks) sonos.suspendTasks();
+    esp_task_wdt_reset();
+
+    SonosDevice* d = sonos.getCurrentDevice();
+    SonosDevice* saved = d ? new SonosDevice(*d) : nullptr;
+    bool saved_lyrics = lyrics_enabled;
+    lyrics_enabled = false;  // No LRCLIB fetches for scripted tracks
+    lv_obj_t* prev_scr = lv_screen_active();
+    String saved_browse_id = current_browse_id;
+    String saved_browse_title = current_browse_title;
+
+    Serial.println("screen,create_us,layout_us,render_us,hash");
+    // Overlay needs fetched lyrics, so this row uses the live track (scripted tracks clear it)
+    if (lyrics_ready && lyric_count > 0) {
+        setLyricsVisible(true);
+        benchScreen("main+lyrics", scr_main, dump_snapshots);
+    }
+
+    // Everything below renders scripted state, so hashes are comparable between runs
+    if (d) {
+        fillQueue();
+        applyStep(d, &steps[0]);
+        sonos.publishSnapshot();
+        updateUI();
+        uint32_t t0 = micros();
+        refreshQueueList();
+        Serial.printf("[BENCH] refreshQueueList (%d items): %lu us\n", d->queueSize, (unsigned long)(micros() - t0));
+    } else {
+        Serial.println("[BENCH] No device - screens show their empty state");
+    }
+    uint32_t t0 = micros();
+    refreshGroupsList();
+    Serial.printf("[BENCH] refreshGroupsList: %lu us\n", (unsigned long)(micros() - t0));
+    t0 = micros();
+    fillBrowse();
+    Serial.printf("[BENCH] browse open (%d items, cached): %lu us\n", BROWSE_PAGE_SIZE, (unsigned long)(micros() - t0));
+
+    benchScreen("main", scr_main, dump_snapshots);
+    benchScreen("queue", scr_queue, dump_snapshots);
+    benchScreen("groups", scr_groups, dump_snapshots);
+    benchScreen("devices", scr_devices, dump_snapshots);
+    benchScreen("sources", scr_sources, dump_snapshots);
+    benchScreen("browse", scr_browse, dump_snapshots);
+    benchScreen("display", scr_display, dump_snapshots);
+    benchScreen("general", scr_general, dump_snapshots);
+    benchScreen("ota", scr_ota, dump_snapshots);
+    benchScreen("wifi", scr_wifi, dump_snapshots);
+
+    if (d) benchSteps(d);
+
+    // Put the real state back and redraw from it (the track change refetches lyrics)
+    lyrics_enabled = saved_lyrics;
+    current_browse_id = saved_browse_id;
+    current_browse_title = saved_browse_title;
+    if (prev_scr == scr_browse) createBrowseScreen();  // Reopen the folder the user was in
+    if (d) {
+        *d = *saved;
+        delete saved;
+        sonos.publishSnapshot();
+        updateUI();
+        refreshQueueList();
+    }
+    lv_screen_load(prev_scr);
+    if (had_tasks) sonos.resumeTasks();
+    if (d) sonos.requestQueueRefresh();  // Replace the scripted queue page
+    Serial.println("[BENCH] Done");
+}
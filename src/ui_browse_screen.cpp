@@ -0,0 +1,495 @@
+/**
+ * UI Browse Screen
+ * Virtual list like the queue screen: BROWSE_ROW_POOL row widgets are rebound to
+ * folder indices while scrolling over a spacer sized from TotalMatches, so a folder
+ * of any length scrolls without a widget per item. Rows read the controller's browse
+ * cache (sonos_browse.cpp); pages that aren't cached are requested on demand and
+ * show a placeholder until they land. Large alphabetical folders get an A-Z strip.
+ * Long-pressing a playable row queues it after the current track.
+ */
+
+#include "ui_common.h"
+
+struct BrowseListRow {
+    lv_obj_t* btn;
+    lv_obj_t* icon;
+    lv_obj_t* label;
+    int index;                           // Bound folder index, -1 = unbound
+    bool loaded;                         // Showing the item, not the placeholder
+};
+
+// Row contents copied out of a cache page, so widgets are bound without holding the cache
+struct BrowseRowText {
+    char title[SNAP_TEXT_LEN];
+    bool container;
+    bool loaded;
+    bool bind;
+};
+
+static lv_obj_t* browse_title = nullptr;
+static lv_obj_t* browse_list = nullptr;
+static lv_obj_t* browse_spacer = nullptr;
+static lv_obj_t* browse_status = nullptr;
+static lv_obj_t* browse_jump = nullptr;  // A-Z strip
+static BrowseListRow browse_rows[BROWSE_ROW_POOL];
+static BrowseRowText row_text[BROWSE_ROW_POOL];
+static int browse_total = -1;            // TotalMatches, -1 = not loaded yet
+static uint32_t browse_update_id = 0;    // Folder UpdateID of the rows shown
+static uint32_t browse_ticket = 0;       // Foreground request for the first page
+static uint32_t browse_version = 0;      // Controller browse version last synced
+static bool browse_retry = false;        // Cache was busy - sync again next pass
+static int browse_first = -1;            // First index the pool was laid out for
+
+static BrowseJumpIndex jump_index;       // Copy for the folder shown (count 0 = none yet)
+static char jump_letter = 0;             // Jump waiting for its pages, 0 = none
+static int jump_from = 0;                // Items that can hold the letter's first title
+static int jump_to = 0;
+static char jump_pressed = 0;            // Letter under the finger (dragging the strip)
+
+static const char JUMP_LETTERS[] = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+#define JUMP_LETTER_COUNT 27
+
+// ============================================================================
+// Navigation
+// ============================================================================
+// Opening a folder rebinds the row pool, so folder changes from a row's own click
+// run after the event
+static void openBrowseAsync(void* param) {
+    createBrowseScreen();
+    lv_screen_load(scr_browse);
+}
+
+void runBrowseAction(uint8_t action, const char* id, const char* title, const char* uri, const char* meta) {
+    switch (action) {
+        case BROWSE_OPEN:
+            current_browse_id = id;
+            current_browse_title = title;
+            lv_async_call(openBrowseAsync, NULL);
+            break;
+        case BROWSE_PLAY_PLAYLIST:
+            Serial.printf("[BROWSE] Playing playlist: %s (ID: %s)\n", title, id);
+            sonos.playPlaylist(id);
+            lv_screen_load(scr_main);
+            break;
+        case BROWSE_PLAY_CONTAINER:
+            Serial.printf("[BROWSE] Playing container: %s\n", title);
+            sonos.playContainer(uri, meta);
+            lv_screen_load(scr_main);
+            break;
+        case BROWSE_PLAY_URI:
+            Serial.printf("[BROWSE] Playing URI: %s\n", uri);
+            sonos.playURI(uri, meta);
+            lv_screen_load(scr_main);
+            break;
+        default:
+            Serial.println("[BROWSE] No URI found!");
+            break;
+    }
+}
+
+// The cached page holds everything a tap needs, pre-parsed
+void activateBrowseItem(const char* folder, int index) {
+    if (!sonos.lockBrowse()) return;
+    const BrowsePage* pg = sonos.getBrowsePage(folder, index);
+    if (!pg || index - pg->start >= pg->count) {
+        sonos.unlockBrowse();
+        Serial.printf("[BROWSE] Page for item %d was evicted - refetching\n", index);
+        sonos.requestBrowse(folder, index, false);
+        return;
+    }
+    const BrowseRow* row = &pg->rows[index - pg->start];
+    uint8_t action = row->action;
+    String id = pg->str(row->id);
+    String title = pg->str(row->title);
+    String uri = pg->str(row->uri);
+    String meta = pg->str(row->meta);
+    sonos.unlockBrowse();
+    runBrowseAction(action, id.c_str(), title.c_str(), uri.c_str(), meta.c_str());
+}
+
+// Queue a cached row after the current track instead of replacing the queue
+static bool enqueueBrowseItem(const char* folder, int index) {
+    if (!sonos.lockBrowse()) return false;
+    const BrowsePage* pg = sonos.getBrowsePage(folder, index);
+    if (!pg || index - pg->start >= pg->count) {
+        sonos.unlockBrowse();
+        return false;
+    }
+    const BrowseRow* row = &pg->rows[index - pg->start];
+    uint8_t action = row->action;
+    String id = pg->str(row->id);
+    String uri = pg->str(row->uri);
+    String meta = pg->str(row->meta);
+    sonos.unlockBrowse();
+
+    switch (action) {
+        case BROWSE_PLAY_PLAYLIST:
+            uri = "file:///jffs/settings/savedqueues.rsq#" + id.substring(3);
+            meta = "";
+            break;
+        case BROWSE_PLAY_CONTAINER:
+        case BROWSE_PLAY_URI:
+            break;
+        default:
+            return false;  // Folders open, they don't queue
+    }
+    Serial.printf("[BROWSE] Play next: %s\n", uri.c_str());
+    return sonos.enqueueURI(uri.c_str(), meta.c_str(), true);
+}
+
+// Rows carry their folder index
+static void ev_browse_item(lv_event_t* e) {
+    int index = (int)(intptr_t)lv_obj_get_user_data((lv_obj_t*)lv_event_get_target(e));
+    activateBrowseItem(current_browse_id.c_str(), index);
+}
+
+// Long press: play next, acknowledged on the row's icon until it is rebound
+static void ev_browse_enqueue(lv_event_t* e) {
+    int index = (int)(intptr_t)lv_obj_get_user_data((lv_obj_t*)lv_event_get_target(e));
+    if (!enqueueBrowseItem(current_browse_id.c_str(), index)) return;
+    BrowseListRow* r = &browse_rows[index % BROWSE_ROW_POOL];
+    if (r->index == index) lv_label_set_text_static(r->icon, LV_SYMBOL_OK);
+}
+
+// ============================================================================
+// Rows
+// ============================================================================
+static void hideBrowseRow(BrowseListRow* r) {
+    if (r->index < 0) return;
+    lv_obj_add_flag(r->btn, LV_OBJ_FLAG_HIDDEN);
+    r->index = -1;
+    r->loaded = false;
+}
+
+static void bindBrowseRow(BrowseListRow* r, int index, const BrowseRowText* t) {
+    r->index = index;
+    r->loaded = t->loaded;
+    lv_obj_set_y(r->btn, index * BROWSE_ROW_HEIGHT);
+    lv_obj_set_user_data(r->btn, (void*)(intptr_t)index);
+    if (t->loaded) {
+        lv_label_set_text_static(r->icon, t->container ? LV_SYMBOL_DIRECTORY : LV_SYMBOL_AUDIO);
+        lv_label_set_text(r->label, t->title);
+    } else {
+        // Page not cached yet - rebound when it lands (browse version bump)
+        lv_label_set_text_static(r->icon, "");
+        lv_label_set_text_static(r->label, "Loading...");
+    }
+    lv_obj_remove_flag(r->btn, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void createBrowseRow(BrowseListRow* r) {
+    r->btn = lv_btn_create(browse_list);
+    lv_obj_set_size(r->btn, lv_pct(100), BROWSE_ROW_HEIGHT - 10);
+    lv_obj_set_style_radius(r->btn, 10, 0);
+    lv_obj_set_style_shadow_width(r->btn, 0, 0);
+    lv_obj_set_style_bg_color(r->btn, COL_CARD, 0);
+    lv_obj_set_style_bg_color(r->btn, COL_BTN_PRESSED, LV_STATE_PRESSED);
+    lv_obj_set_style_pad_all(r->btn, 15, 0);
+    lv_obj_add_flag(r->btn, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(r->btn, ev_browse_item, LV_EVENT_SHORT_CLICKED, NULL);
+    lv_obj_add_event_cb(r->btn, ev_browse_enqueue, LV_EVENT_LONG_PRESSED, NULL);
+
+    r->icon = lv_label_create(r->btn);
+    lv_obj_set_style_text_color(r->icon, COL_ACCENT, 0);
+    lv_obj_set_style_text_font(r->icon, &lv_font_montserrat_20, 0);
+    lv_obj_align(r->icon, LV_ALIGN_LEFT_MID, 5, 0);
+
+    r->label = lv_label_create(r->btn);
+    lv_obj_set_style_text_color(r->label, COL_TEXT, 0);
+    lv_obj_set_style_text_font(r->label, &lv_font_montserrat_16, 0);
+    lv_obj_align(r->label, LV_ALIGN_LEFT_MID, 40, 0);
+    lv_label_set_long_mode(r->label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_set_width(r->label, lv_pct(90));
+
+    r->index = -1;
+    r->loaded = false;
+}
+
+static void setBrowseTotal(int total, uint32_t updateID) {
+    browse_total = total;
+    browse_update_id = updateID;
+    jump_index.count = 0;  // Sampled again for this folder version
+    jump_letter = 0;
+    lv_obj_set_height(browse_spacer, total > 0 ? total * BROWSE_ROW_HEIGHT - 10 : 0);
+    lv_obj_update_layout(browse_list);
+    lv_obj_readjust_scroll(browse_list, LV_ANIM_OFF);  // Folder may have shrunk below the scroll position
+}
+
+// Bind the pool to the rows around the scroll position (index i lives in slot
+// i % BROWSE_ROW_POOL) and request the pages they need, plus one screen ahead
+static int firstBrowseRow() {
+    int first = lv_obj_get_scroll_y(browse_list) / BROWSE_ROW_HEIGHT - BROWSE_ROW_OVERSCAN;
+    return first < 0 ? 0 : first;
+}
+
+static void layoutBrowseRows(bool rebind_all) {
+    const char* id = current_browse_id.c_str();
+    int first = firstBrowseRow();
+    browse_first = first;
+
+    if (!sonos.lockBrowse()) {
+        browse_retry = true;
+        return;
+    }
+    // A page under another UpdateID means the folder changed since the rows were bound
+    const BrowsePage* pg = sonos.getBrowsePage(id, first);
+    if (!pg) pg = sonos.getBrowsePage(id, 0);
+    bool changed = pg && pg->updateID != browse_update_id;
+    int new_total = pg ? pg->total : 0;
+    uint32_t new_id = pg ? pg->updateID : 0;
+    int missing = -1;
+    for (int i = first; i < first + BROWSE_ROW_POOL && !changed; i++) {
+        BrowseListRow* r = &browse_rows[i % BROWSE_ROW_POOL];
+        BrowseRowText* t = &row_text[i % BROWSE_ROW_POOL];
+        t->bind = rebind_all || r->index != i || !r->loaded;
+        t->loaded = false;
+        if (!t->bind || i >= browse_total) continue;
+        pg = sonos.getBrowsePage(id, i);
+        if (pg && i - pg->start < pg->count) {
+            const BrowseRow* row = &pg->rows[i - pg->start];
+            strlcpy(t->title, pg->str(row->title), sizeof(t->title));
+            t->container = row->container;
+            t->loaded = true;
+        } else if (!pg && missing < 0) {
+            missing = i;
+        }
+    }
+    sonos.unlockBrowse();
+
+    if (changed) {
+        Serial.printf("[BROWSE] %s changed - reloading\n", id);
+        setBrowseTotal(new_total, new_id);
+        layoutBrowseRows(true);
+        return;
+    }
+    for (int i = first; i < first + BROWSE_ROW_POOL; i++) {
+        BrowseListRow* r = &browse_rows[i % BROWSE_ROW_POOL];
+        BrowseRowText* t = &row_text[i % BROWSE_ROW_POOL];
+        if (i >= browse_total) hideBrowseRow(r);
+        else if (t->bind) bindBrowseRow(r, i, t);
+    }
+
+    // 0 = cached (it landed meanwhile) or the cache was busy - look again next pass
+    if (missing >= 0 && sonos.requestBrowse(id, missing, false) == 0) browse_retry = true;
+    int ahead = first + 2 * BROWSE_ROW_POOL;
+    if (ahead < browse_total) sonos.requestBrowse(id, ahead, false);
+}
+
+static void hideBrowseRows() {
+    for (int i = 0; i < BROWSE_ROW_POOL; i++) hideBrowseRow(&browse_rows[i]);
+}
+
+static void updateBrowseStatus() {
+    const char* text = nullptr;
+    if (browse_total == 0) text = "No items found";
+    else if (browse_total < 0) text = sonos.browseFailed(browse_ticket) ? "Couldn't load this folder" : "Loading...";
+    if (text) {
+        lv_label_set_text_static(browse_status, text);
+        lv_obj_remove_flag(browse_status, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(browse_status, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void ev_browse_scroll(lv_event_t* e) {
+    if (browse_total <= 0 || firstBrowseRow() == browse_first) return;  // Moved within a row
+    layoutBrowseRows(false);
+}
+
+// ============================================================================
+// A-Z jump strip
+// ============================================================================
+// Scroll to the first title at or after the letter once the pages between the two
+// samples around it are cached (requests them otherwise; called again on landing)
+static void refineJump() {
+    if (!jump_letter) return;
+    const char* id = current_browse_id.c_str();
+    if (!sonos.lockBrowse()) {
+        browse_retry = true;
+        return;
+    }
+    int target = -1;
+    int missing = -1;
+    int i = jump_from;
+    while (i <= jump_to && target < 0) {
+        const BrowsePage* pg = sonos.getBrowsePage(id, i);
+        if (!pg) {
+            missing = i;
+            break;
+        }
+        int end = pg->start + pg->count;
+        if (end <= i) break;  // Short page - the folder changed
+        for (; i < end && i <= jump_to; i++) {
+            if (browseSortKey(pg->str(pg->rows[i - pg->start].title)) >= jump_letter) {
+                target = i;
+                break;
+            }
+        }
+    }
+    sonos.unlockBrowse();
+
+    if (missing >= 0) {
+        if (sonos.requestBrowse(id, missing, false) == 0) browse_retry = true;
+        return;
+    }
+    jump_letter = 0;
+    if (target < 0) target = jump_to;
+    lv_obj_scroll_to_y(browse_list, target * BROWSE_ROW_HEIGHT, LV_ANIM_OFF);
+}
+
+// Samples bracket the letter; jump to the lower one right away, refine when cached
+static void jumpToLetter(char letter) {
+    int k;
+    char last = '\0';
+    for (k = 0; k < jump_index.count; k++) {
+        char c = jump_index.key[k];
+        if (c == '#' && last >= 'A') c = last;  // Accented / symbol title sorted in place
+        last = c;
+        if (c >= letter) break;
+    }
+    jump_from = k > 0 ? jump_index.index[k - 1] : 0;
+    jump_to = k < jump_index.count ? jump_index.index[k] : browse_total - 1;
+    jump_letter = letter;
+    lv_obj_scroll_to_y(browse_list, jump_from * BROWSE_ROW_HEIGHT, LV_ANIM_OFF);
+    refineJump();
+}
+
+static void ev_browse_jump(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_RELEASED) {
+        jump_pressed = 0;
+        return;
+    }
+    lv_indev_t* indev = lv_indev_active();
+    if (!indev) return;
+    lv_point_t p;
+    lv_indev_get_point(indev, &p);
+    lv_area_t a;
+    lv_obj_get_coords(browse_jump, &a);
+    int slot = (p.y - a.y1) * JUMP_LETTER_COUNT / lv_area_get_height(&a);
+    if (slot < 0) slot = 0;
+    if (slot >= JUMP_LETTER_COUNT) slot = JUMP_LETTER_COUNT - 1;
+    char letter = JUMP_LETTERS[slot];
+    if (letter == jump_pressed) return;  // Still on the same letter while dragging
+    jump_pressed = letter;
+    jumpToLetter(letter);
+}
+
+// Request the folder's jump index once it is large enough; show it if sorted
+static void updateJumpStrip() {
+    const char* id = current_browse_id.c_str();
+    if (jump_index.count == 0 && browse_total >= BROWSE_JUMP_MIN_ITEMS) {
+        sonos.requestBrowseJump(id, browse_total, browse_update_id);  // No-op once requested
+        sonos.getBrowseJump(id, browse_update_id, &jump_index);
+    }
+    bool show = jump_index.count > 0 && jump_index.sorted && browse_total >= BROWSE_JUMP_MIN_ITEMS;
+    if (show == !lv_obj_has_flag(browse_jump, LV_OBJ_FLAG_HIDDEN)) return;
+    if (show) lv_obj_remove_flag(browse_jump, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(browse_jump, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_width(browse_list, show ? lv_pct(93) : lv_pct(100));  // Leave the strip its column
+}
+
+// ============================================================================
+// Sync
+// ============================================================================
+static void syncBrowse() {
+    browse_version = sonos.getBrowseVersion();
+    browse_retry = false;
+    const char* id = current_browse_id.c_str();
+    if (browse_total < 0) {
+        // First page not cached yet (evicted, or the request couldn't be posted)
+        if (browse_ticket == 0) browse_ticket = sonos.requestBrowse(id, 0, true);
+        if (!sonos.lockBrowse()) {
+            browse_retry = true;
+            return;
+        }
+        const BrowsePage* pg = sonos.getBrowsePage(id, 0);
+        int total = pg ? pg->total : -1;
+        uint32_t updateID = pg ? pg->updateID : 0;
+        sonos.unlockBrowse();
+        if (total >= 0) setBrowseTotal(total, updateID);
+    }
+    if (browse_total >= 0) {
+        layoutBrowseRows(false);
+        updateJumpStrip();
+        refineJump();
+    }
+    updateBrowseStatus();
+}
+
+// Called every UI pass - cheap unless a page landed
+void syncBrowseList() {
+    if (!browse_list || lv_screen_active() != scr_browse) return;
+    if (sonos.getBrowseVersion() == browse_version && !browse_retry) return;
+    syncBrowse();
+}
+
+// ============================================================================
+// Browse Screen
+// ============================================================================
+void createBrowseScreen() {
+    if (!scr_browse) {
+        scr_browse = lv_obj_create(NULL);
+        lv_obj_set_style_bg_color(scr_browse, lv_color_hex(0x121212), 0);
+
+        // Create sidebar and get content area (Sources is index 3)
+        lv_obj_t* content = createSettingsSidebar(scr_browse, 3);
+        lv_obj_clear_flag(content, LV_OBJ_FLAG_SCROLLABLE);
+
+        // Title
+        browse_title = lv_label_create(content);
+        lv_obj_set_style_text_font(browse_title, &lv_font_montserrat_24, 0);
+        lv_obj_set_style_text_color(browse_title, COL_TEXT, 0);
+        lv_obj_set_pos(browse_title, 0, 0);
+
+        // Content list (rows positioned absolutely, no flex)
+        browse_list = lv_obj_create(content);
+        lv_obj_set_pos(browse_list, 0, 50);
+        lv_obj_set_size(browse_list, lv_pct(100), 405);
+        lv_obj_set_style_bg_color(browse_list, COL_BG, 0);
+        lv_obj_set_style_border_width(browse_list, 0, 0);
+        lv_obj_set_style_pad_all(browse_list, 0, 0);
+        lv_obj_set_scroll_dir(browse_list, LV_DIR_VER);
+        lv_obj_add_event_cb(browse_list, ev_browse_scroll, LV_EVENT_SCROLL, NULL);
+
+        // Spacer sets the scroll range; the row pool floats over it
+        browse_spacer = lv_obj_create(browse_list);
+        lv_obj_remove_style_all(browse_spacer);
+        lv_obj_set_size(browse_spacer, 1, 0);
+        lv_obj_remove_flag(browse_spacer, LV_OBJ_FLAG_CLICKABLE);
+        for (int i = 0; i < BROWSE_ROW_POOL; i++) createBrowseRow(&browse_rows[i]);
+
+        // A-Z strip right of the list - one label, the letter comes from the touch y
+        browse_jump = lv_label_create(content);
+        lv_label_set_text_static(browse_jump, "#\nA\nB\nC\nD\nE\nF\nG\nH\nI\nJ\nK\nL\nM\nN\nO\nP\nQ\nR\nS\nT\nU\nV\nW\nX\nY\nZ");
+        lv_obj_set_style_text_font(browse_jump, &lv_font_montserrat_12, 0);
+        lv_obj_set_style_text_color(browse_jump, COL_ACCENT, 0);
+        lv_obj_set_style_text_align(browse_jump, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_set_style_text_line_space(browse_jump, 0, 0);
+        lv_obj_set_size(browse_jump, 32, 405);
+        lv_obj_align(browse_jump, LV_ALIGN_TOP_RIGHT, 0, 50);
+        lv_obj_add_flag(browse_jump, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_flag(browse_jump, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(browse_jump, ev_browse_jump, LV_EVENT_PRESSED, NULL);
+        lv_obj_add_event_cb(browse_jump, ev_browse_jump, LV_EVENT_PRESSING, NULL);
+        lv_obj_add_event_cb(browse_jump, ev_browse_jump, LV_EVENT_RELEASED, NULL);
+
+        // Loading / empty / error state, over the list
+        browse_status = lv_label_create(content);
+        lv_obj_set_style_text_color(browse_status, COL_TEXT2, 0);
+        lv_obj_set_style_text_font(browse_status, &lv_font_montserrat_16, 0);
+        lv_obj_set_pos(browse_status, 0, 60);
+    }
+
+    lv_label_set_text(browse_title, current_browse_title.c_str());
+    hideBrowseRows();
+    setBrowseTotal(0, 0);
+    browse_total = -1;
+    lv_obj_scroll_to_y(browse_list, 0, LV_ANIM_OFF);
+    lv_obj_add_flag(browse_jump, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_width(browse_list, lv_pct(100));
+    browse_ticket = sonos.requestBrowse(current_browse_id.c_str(), 0, true);
+    Serial.printf("[BROWSE] Open %s (%s)\n", current_browse_id.c_str(), browse_ticket ? "fetching" : "cached");
+
+    // Cached pages show right away; the rest arrive through syncBrowseList()
+    syncBrowse();
+}
@@ -1,11 +1,12 @@
 /**
  * General Settings Screen
- * Lyrics and other general preferences
+ * Lyrics, performance overlay and other general preferences
  */
 
 #include "ui_common.h"
 #include "config.h"
 #include "lyrics.h"
+#include "frame_profiler.h"
 
 // Forward declaration
 lv_obj_t* createSettingsSidebar(lv_obj_t* screen, int activeIdx);
@@ -60,4 +61,35 @@ void createGeneralScreen() {
         wifiPrefs.putBool("lyrics", lyrics_enabled);
         setLyricsVisible(lyrics_enabled && lyrics_ready);
     }, LV_EVENT_VALUE_CHANGED, NULL);
+
+    // Performance overlay toggle
+    lv_obj_t* lbl_perf = lv_label_create(content);
+    lv_label_set_text(lbl_perf, "Performance Overlay:");
+    lv_obj_set_style_text_color(lbl_perf, COL_TEXT, 0);
+    lv_obj_set_style_text_font(lbl_perf, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_pad_top(lbl_perf, 24, 0);
+
+    lv_obj_t* lbl_perf_desc = lv_label_create(content);
+    lv_label_set_text(lbl_perf_desc, "Frame rate and render/rotate/transfer times (serial: \"perf\" dumps CSV)");
+    lv_obj_set_style_text_color(lbl_perf_desc, COL_TEXT2, 0);
+    lv_obj_set_style_text_font(lbl_perf_desc, &lv_font_montserrat_14, 0);
+
+    lv_obj_t* sw_perf = lv_switch_create(content);
+    lv_obj_set_size(sw_perf, 50, 26);
+    lv_obj_set_style_margin_top(sw_perf, 8, 0);
+    lv_obj_set_style_radius(sw_perf, 13, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(sw_perf, lv_color_hex(0x333333), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(sw_perf, COL_ACCENT, (lv_style_selector_t)((uint32_t)LV_PART_INDICATOR | (uint32_t)LV_STATE_CHECKED));
+    lv_obj_set_style_radius(sw_perf, 13, LV_PART_INDICATOR);
+    lv_obj_set_style_pad_all(sw_perf, 0, LV_PART_INDICATOR);
+    lv_obj_set_style_bg_color(sw_perf, COL_TEXT, LV_PART_KNOB);
+    lv_obj_set_style_radius(sw_perf, 11, LV_PART_KNOB);
+    lv_obj_set_style_pad_all(sw_perf, -3, LV_PART_KNOB);
+    if (wifiPrefs.getBool(NVS_KEY_PERF_OVERLAY, false)) lv_obj_add_state(sw_perf, LV_STATE_CHECKED);
+    lv_obj_add_event_cb(sw_perf, [](lv_event_t* e) {
+        lv_obj_t* sw = (lv_obj_t*)lv_event_get_target(e);
+        bool on = lv_obj_has_state(sw, LV_STATE_CHECKED);
+        wifiPrefs.putBool(NVS_KEY_PERF_OVERLAY, on);
+        profilerSetOverlay(on);
+    }, LV_EVENT_VALUE_CHANGED, NULL);
 }
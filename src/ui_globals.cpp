@@ -44,6 +44,7 @@ lv_obj_t *scr_settings = nullptr;
 lv_obj_t *scr_wifi = nullptr;
 lv_obj_t *scr_sources = nullptr;
 lv_obj_t *scr_browse = nullptr;
+lv_obj_t *scr_search = nullptr;
 lv_obj_t *scr_display = nullptr;
 lv_obj_t *scr_ota = nullptr;
 lv_obj_t *scr_groups = nullptr;
@@ -125,6 +126,7 @@ int art_offset_x = 0;
 int art_offset_y = 0;
 bool is_sonos_radio_art = false;
 bool pending_is_station_logo = false;
+uint32_t pending_art_thumb_key = 0;
 volatile unsigned long last_queue_fetch_time = 0;
 SemaphoreHandle_t network_mutex = NULL;  // Created in main.cpp
 volatile unsigned long last_network_end_ms = 0;  // Last network operation end time (for SDIO cooldown)
@@ -133,13 +135,6 @@ volatile unsigned long last_https_end_ms = 0;   // Last HTTPS operation end time
 // ============================================================================
 // UI State
 // ============================================================================
-String ui_title = "";
-String ui_artist = "";
-String ui_repeat = "";
-int ui_vol = -1;
-bool ui_playing = false;
-bool ui_shuffle = false;
-bool ui_muted = false;
 bool dragging_vol = false;
 bool dragging_prog = false;
 
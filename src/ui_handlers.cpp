@@ -6,6 +6,9 @@
 #include "ui_common.h"
 #include "config.h"
 #include "lyrics.h"
+#include "art_thumbs.h"
+#include "render_governor.h"
+#include "alloc_trace.h"
 #include <esp_task_wdt.h>
 
 // ============================================================================
@@ -19,6 +22,7 @@ void setBrightness(int level) {
 
 void resetScreenTimeout() {
     last_touch_time = millis();
+    governorActivity();
     if (screen_dimmed) {
         // Instant wake-up - no animation
         display_set_brightness(brightness_level);
@@ -46,18 +50,20 @@ void checkAutoDim() {
         lv_anim_set_duration(&anim, 1000);  // 1 second smooth fade
         lv_anim_set_exec_cb(&anim, brightness_anim_cb);
         lv_anim_set_path_cb(&anim, lv_anim_path_ease_in);
-        lv_anim_start(&anim);
+        governorAnimStart(&anim);
 
         screen_dimmed = true;
     }
 }
 
+// Playback state last applied to the widgets (copied from the controller's snapshot)
+static SonosSnapshot ui_snap;
+
 // ============================================================================
 // Playback Event Handlers
 // ============================================================================
 void ev_play(lv_event_t* e) {
-    SonosDevice* d = sonos.getCurrentDevice();
-    if (d) d->isPlaying ? sonos.pause() : sonos.play();
+    if (sonos.getCurrentDevice()) ui_snap.isPlaying ? sonos.pause() : sonos.play();
 }
 
 void ev_prev(lv_event_t* e) {
@@ -69,15 +75,13 @@ void ev_next(lv_event_t* e) {
 }
 
 void ev_shuffle(lv_event_t* e) {
-    SonosDevice* d = sonos.getCurrentDevice();
-    if (d) sonos.setShuffle(!d->shuffleMode);
+    if (sonos.getCurrentDevice()) sonos.setShuffle(!ui_snap.shuffleMode);
 }
 
 void ev_repeat(lv_event_t* e) {
-    SonosDevice* d = sonos.getCurrentDevice();
-    if (!d) return;
-    if (d->repeatMode == "NONE") sonos.setRepeat("ALL");
-    else if (d->repeatMode == "ALL") sonos.setRepeat("ONE");
+    if (!sonos.getCurrentDevice()) return;
+    if (ui_snap.repeatMode == SNAP_REPEAT_NONE) sonos.setRepeat("ALL");
+    else if (ui_snap.repeatMode == SNAP_REPEAT_ALL) sonos.setRepeat("ONE");
     else sonos.setRepeat("NONE");
 }
 
@@ -85,8 +89,7 @@ void ev_progress(lv_event_t* e) {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_PRESSING) dragging_prog = true;
     else if (code == LV_EVENT_RELEASED) {
-        SonosDevice* d = sonos.getCurrentDevice();
-        if (d && d->durationSeconds > 0) sonos.seek((lv_slider_get_value(slider_progress) * d->durationSeconds) / 100);
+        if (ui_snap.durationSeconds > 0) sonos.seek((lv_slider_get_value(slider_progress) * ui_snap.durationSeconds) / 100);
         dragging_prog = false;
     }
 }
@@ -101,8 +104,7 @@ void ev_vol_slider(lv_event_t* e) {
 }
 
 void ev_mute(lv_event_t* e) {
-    SonosDevice* d = sonos.getCurrentDevice();
-    if (d) sonos.setMute(!d->isMuted);
+    if (sonos.getCurrentDevice()) sonos.setMute(!ui_snap.isMuted);
 }
 
 void ev_queue_item(lv_event_t* e) {
@@ -119,7 +121,8 @@ void ev_devices(lv_event_t* e) {
 }
 
 void ev_queue(lv_event_t* e) {
-    sonos.updateQueue();
+    // Show the resident pages now; the refresh lands as a queue change-set
+    sonos.requestQueueRefresh();
     refreshQueueList();
     lv_screen_load(scr_queue);
 }
@@ -1089,366 +1092,356 @@ void ev_install_update(lv_event_t* e) {
 // ============================================================================
 // UI Update Function
 // ============================================================================
-void updateUI() {
-    SonosDevice* d = sonos.getCurrentDevice();
-    if (!d) return;
 
-    // Track connection state - start as disconnected to avoid false triggers
-    static bool was_connected = false;
-    static bool ui_cleared = false;
-    static bool last_conn_state = false;
+// Next-panel thumbnail (pinned in the thumbnail cache while shown)
+static const lv_image_dsc_t* next_thumb = nullptr;
 
-    // Debug: Log connection state changes
-    if (d->connected != last_conn_state) {
-        Serial.printf("[UI] Connection state changed: %s (errorCount=%d)\n",
-                     d->connected ? "CONNECTED" : "DISCONNECTED", d->errorCount);
-        last_conn_state = d->connected;
-    }
-
-    // Handle disconnection - only clear UI once
-    if (!d->connected) {
-        if (was_connected || !ui_cleared) {
-            // Device just disconnected or first time showing disconnect state
-            lv_label_set_text(lbl_title, "Device Not Connected");
-            lv_label_set_text(lbl_artist, "");
-            lv_label_set_text(lbl_album, "");
-            lv_label_set_text(lbl_time, "0:00");
-            lv_label_set_text(lbl_time_remaining, "0:00");
-            lv_slider_set_value(slider_progress, 0, LV_ANIM_OFF);
-
-            // Hide album art, show placeholder
-            lv_obj_add_flag(img_album, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_remove_flag(art_placeholder, LV_OBJ_FLAG_HIDDEN);
-
-            // Hide next track info
-            lv_obj_add_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
-
-            // Reset background color to default dark
-            if (panel_art) lv_obj_set_style_bg_color(panel_art, lv_color_hex(0x1a1a1a), 0);
-            if (panel_right) lv_obj_set_style_bg_color(panel_right, COL_BG, 0);
-
-            // Reset play button to pause icon
-            lv_obj_t* lbl = lv_obj_get_child(btn_play, 0);
-            lv_label_set_text(lbl, LV_SYMBOL_PAUSE);
-            lv_obj_center(lbl);
-
-            ui_title = "";
-            ui_artist = "";
-            was_connected = false;
-            ui_cleared = true;
-            Serial.println("[UI] Device disconnected - UI cleared");
-        }
-        return;  // Don't update UI when disconnected
+static void setNextThumb(const lv_image_dsc_t* dsc) {
+    if (dsc == next_thumb) {
+        if (dsc) artThumbRelease(dsc);  // Already pinned once - drop the extra pin
+        return;
     }
-
-    // Handle reconnection - force UI refresh
-    if (d->connected && !was_connected) {
-        was_connected = true;
-        ui_cleared = false;
-        // Force refresh of all UI elements by clearing cached values
-        ui_title = "";
-        ui_artist = "";
-        Serial.println("[UI] Device reconnected - forcing UI refresh");
+    if (next_thumb) artThumbRelease(next_thumb);
+    next_thumb = dsc;
+    if (!img_next_album) return;
+    if (dsc) {
+        lv_image_set_src(img_next_album, dsc);
+        lv_obj_clear_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_image_set_src(img_next_album, NULL);
+        lv_obj_add_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
     }
+}
 
-    // Device is connected - update UI normally
-
-    // Title
-    if (d->currentTrack != ui_title) {
-        lv_label_set_text(lbl_title, d->currentTrack.length() > 0 ? d->currentTrack.c_str() : "Not Playing");
-        ui_title = d->currentTrack;
-    }
+// FNV-1a of "artist|title" - identifies a track for the lyrics fetch
+static uint32_t trackKey(const char* artist, const char* title) {
+    uint32_t h = 2166136261u;
+    for (const char* p = artist; *p; p++) { h ^= (uint8_t)*p; h *= 16777619u; }
+    h ^= '|'; h *= 16777619u;
+    for (const char* p = title; *p; p++) { h ^= (uint8_t)*p; h *= 16777619u; }
+    return h;
+}
 
-    // Artist
-    if (d->currentArtist != ui_artist) {
-        lv_label_set_text(lbl_artist, d->currentArtist.c_str());
-        ui_artist = d->currentArtist;
-    }
+// ----------------------------------------------------------------------------
+// Per-widget apply functions. Each one owns the widgets behind its SNAP_* bits,
+// so a volume change never touches title, art, lyrics or next-track code.
+// ----------------------------------------------------------------------------
+static bool prog_stale = false;   // Position changed while the slider was being dragged
+static bool vol_stale = false;    // Volume changed while the slider was being dragged
+static uint32_t next_thumb_key = 0;   // Cache key of the next track's art
+static uint32_t next_thumb_gen = 0;   // artThumbGeneration() at last lookup
+static bool art_retry = false;        // requestAlbumArt() found the art mutex busy
+
+static void clearDisconnected() {
+    lv_label_set_text(lbl_title, "Device Not Connected");
+    lv_label_set_text(lbl_artist, "");
+    lv_label_set_text(lbl_album, "");
+    lv_label_set_text(lbl_time, "0:00");
+    lv_label_set_text(lbl_time_remaining, "0:00");
+    lv_slider_set_value(slider_progress, 0, LV_ANIM_OFF);
+
+    // Hide album art, show placeholder
+    lv_obj_add_flag(img_album, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_remove_flag(art_placeholder, LV_OBJ_FLAG_HIDDEN);
+
+    // Hide next track info
+    lv_obj_add_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
+
+    // Reset background color to default dark
+    if (panel_art) lv_obj_set_style_bg_color(panel_art, lv_color_hex(0x1a1a1a), 0);
+    if (panel_right) lv_obj_set_style_bg_color(panel_right, COL_BG, 0);
+
+    // Reset play button to pause icon
+    lv_obj_t* lbl = lv_obj_get_child(btn_play, 0);
+    lv_label_set_text(lbl, LV_SYMBOL_PAUSE);
+    lv_obj_center(lbl);
+}
 
-    // Fetch synced lyrics when track changes
-    static String lyrics_last_track = "";
-    String lyrics_key = d->currentArtist + "|" + d->currentTrack;
-    if (lyrics_key != lyrics_last_track && d->currentTrack.length() > 0) {
-        lyrics_last_track = lyrics_key;
-        if (lyrics_enabled && !d->isRadioStation && d->durationSeconds > 0) {
-            requestLyrics(d->currentArtist, d->currentTrack, d->durationSeconds);
+// Title / artist, and synced lyrics for the new track
+static void applyTitle(const SonosSnapshot* s) {
+    static uint32_t lyrics_track_key = 0;
+    lv_label_set_text(lbl_title, s->title[0] ? s->title : "Not Playing");
+    lv_label_set_text(lbl_artist, s->artist);
+    uint32_t key = trackKey(s->artist, s->title);
+    if (s->title[0] && key != lyrics_track_key) {
+        lyrics_track_key = key;
+        if (lyrics_enabled && !s->isRadioStation && s->durationSeconds > 0) {
+            requestLyrics(s->artist, s->title, s->durationSeconds);
         } else {
             clearLyrics();
         }
     }
+}
 
-    // Album name (below album art)
-    static String ui_album_name = "";
-    if (d->currentAlbum != ui_album_name) {
-        lv_label_set_text(lbl_album, d->currentAlbum.c_str());
-        ui_album_name = d->currentAlbum;
-    }
-
-    // Device name in header
-    static String ui_device_name = "";
-    if (d->roomName != ui_device_name) {
-        String np = "Now Playing - " + d->roomName;
-        lv_label_set_text(lbl_device_name, np.c_str());
-        ui_device_name = d->roomName;
-    }
-
-    // Time display
-    String t = d->relTime;
-    if (t.startsWith("0:")) t = t.substring(2);
-    lv_label_set_text(lbl_time, t.c_str());
-
-    // Total duration
-    if (d->durationSeconds > 0) {
-        int dm = d->durationSeconds / 60;
-        int ds = d->durationSeconds % 60;
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%d:%02d", dm, ds);
-        lv_label_set_text(lbl_time_remaining, buf);
-    }
-
-    // Progress slider
-    if (!dragging_prog && d->durationSeconds > 0)
-        lv_slider_set_value(slider_progress, (d->relTimeSeconds * 100) / d->durationSeconds, LV_ANIM_OFF);
-
-    // Update synced lyrics display and status indicator
-    updateLyricsDisplay(d->relTimeSeconds);
-    updateLyricsStatus();  // Update status indicator from main thread
+// Album name (below album art)
+static void applyAlbum(const SonosSnapshot* s) {
+    lv_label_set_text(lbl_album, s->album);
+}
 
-    // Play/Pause button
-    if (d->isPlaying != ui_playing) {
-        lv_obj_t* lbl = lv_obj_get_child(btn_play, 0);
-        lv_label_set_text(lbl, d->isPlaying ? LV_SYMBOL_PAUSE : LV_SYMBOL_PLAY);
+// Device name in header
+static void applyRoom(const SonosSnapshot* s) {
+    static char room_text[80];
+    snprintf(room_text, sizeof(room_text), "Now Playing - %s", s->roomName);
+    lv_label_set_text_static(lbl_device_name, room_text);
+}
 
-        // Center the icon properly - play triangle needs offset to look centered
-        if (d->isPlaying) {
-            lv_obj_center(lbl);  // Pause is centered
-        } else {
-            lv_obj_align(lbl, LV_ALIGN_CENTER, 2, 0);  // Play needs 2px right offset
-        }
+static void applyProgressSlider(const SonosSnapshot* s) {
+    if (s->durationSeconds > 0)
+        lv_slider_set_value(slider_progress, (s->relTimeSeconds * 100) / s->durationSeconds, LV_ANIM_OFF);
+    prog_stale = false;
+}
 
-        ui_playing = d->isPlaying;
-    }
+// Time display, total duration, progress slider and the synced lyric line.
+// Runs on every position tick, so the labels point at fixed buffers (set_text_static):
+// only a lyric line change allocates (label text + fade animation)
+static void applyPosition(const SonosSnapshot* s) {
+    static char time_text[12];
+    static char duration_text[12];
+    int t = s->relTimeSeconds;
+    if (t >= 3600) snprintf(time_text, sizeof(time_text), "%d:%02d:%02d", t / 3600, (t / 60) % 60, t % 60);
+    else snprintf(time_text, sizeof(time_text), "%02d:%02d", t / 60, t % 60);
+    lv_label_set_text_static(lbl_time, time_text);
+
+    if (s->durationSeconds > 0) {
+        snprintf(duration_text, sizeof(duration_text), "%d:%02d", s->durationSeconds / 60, s->durationSeconds % 60);
+        lv_label_set_text_static(lbl_time_remaining, duration_text);
+    }
+    if (dragging_prog) prog_stale = true;
+    else applyProgressSlider(s);
+
+    updateLyricsDisplay(s->relTimeSeconds);
+}
 
-    // Volume slider update
-    if (!dragging_vol && d->volume != ui_vol && slider_vol) {
-        lv_slider_set_value(slider_vol, d->volume, LV_ANIM_OFF);
-        ui_vol = d->volume;
-    }
+// Play/Pause button
+static void applyPlayState(const SonosSnapshot* s) {
+    lv_obj_t* lbl = lv_obj_get_child(btn_play, 0);
+    lv_label_set_text_static(lbl, s->isPlaying ? LV_SYMBOL_PAUSE : LV_SYMBOL_PLAY);
 
-    // Mute button
-    if (d->isMuted != ui_muted && btn_mute) {
-        lv_obj_t* lbl = lv_obj_get_child(btn_mute, 0);
-        lv_label_set_text(lbl, d->isMuted ? LV_SYMBOL_MUTE : LV_SYMBOL_VOLUME_MAX);
-        ui_muted = d->isMuted;
+    // Center the icon properly - play triangle needs offset to look centered
+    if (s->isPlaying) {
+        lv_obj_center(lbl);  // Pause is centered
+    } else {
+        lv_obj_align(lbl, LV_ALIGN_CENTER, 2, 0);  // Play needs 2px right offset
     }
+}
 
-    // Shuffle
-    if (d->shuffleMode != ui_shuffle) {
-        lv_obj_t* lbl = lv_obj_get_child(btn_shuffle, 0);
-        lv_obj_set_style_text_color(lbl, d->shuffleMode ? COL_ACCENT : COL_TEXT2, 0);
-        ui_shuffle = d->shuffleMode;
+// Volume slider (held back while the user drags it)
+static void applyVolume(const SonosSnapshot* s) {
+    if (!slider_vol) return;
+    if (dragging_vol) {
+        vol_stale = true;
+        return;
     }
+    lv_slider_set_value(slider_vol, s->volume, LV_ANIM_OFF);
+    vol_stale = false;
+}
 
-    // Next track info - find next track in queue
-    // SKIP FOR RADIO MODE - radio stations don't have a queue/next track
-    static String last_next_title = "";
-    if (!d->isRadioStation && d->queueSize > 0 && d->currentTrackNumber > 0) {
-        int nextIdx = -1;
-
-        // Find next track after current
-        for (int i = 0; i < d->queueSize; i++) {
-            if (d->queue[i].trackNumber == d->currentTrackNumber + 1) {
-                nextIdx = i;
-                break;
-            }
-        }
+static void applyMute(const SonosSnapshot* s) {
+    if (!btn_mute) return;
+    lv_obj_t* lbl = lv_obj_get_child(btn_mute, 0);
+    lv_label_set_text_static(lbl, s->isMuted ? LV_SYMBOL_MUTE : LV_SYMBOL_VOLUME_MAX);
+}
 
-        // If we're on last track and repeat is on, show first track
-        if (nextIdx < 0 && (d->repeatMode == "ALL" || d->repeatMode == "ONE")) {
-            for (int i = 0; i < d->queueSize; i++) {
-                if (d->queue[i].trackNumber == 1) {
-                    nextIdx = i;
-                    break;
-                }
-            }
-        }
+static void applyShuffle(const SonosSnapshot* s) {
+    lv_obj_t* lbl = lv_obj_get_child(btn_shuffle, 0);
+    lv_obj_set_style_text_color(lbl, s->shuffleMode ? COL_ACCENT : COL_TEXT2, 0);
+}
 
-        if (nextIdx >= 0 && d->queue[nextIdx].title.length() > 0) {
-            String nextTitle = d->queue[nextIdx].title;
-            if (nextTitle != last_next_title) {
-                lv_label_set_text(lbl_next_title, d->queue[nextIdx].title.c_str());
-                lv_label_set_text(lbl_next_artist, d->queue[nextIdx].artist.c_str());
-                lv_obj_clear_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
-                last_next_title = nextTitle;
-            }
-        } else if (nextIdx < 0) {
-            // Only hide if next track is truly unavailable (not just temporarily)
-            if (last_next_title != "") {
-                lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
-                last_next_title = "";
-            }
-        }
+static void applyRepeat(const SonosSnapshot* s) {
+    lv_obj_t* lbl = lv_obj_get_child(btn_repeat, 0);
+    if (s->repeatMode == SNAP_REPEAT_ONE) {
+        lv_label_set_text_static(lbl, "1");
+        lv_obj_set_style_text_color(lbl, COL_ACCENT, 0);
+    } else if (s->repeatMode == SNAP_REPEAT_ALL) {
+        lv_label_set_text_static(lbl, LV_SYMBOL_LOOP);
+        lv_obj_set_style_text_color(lbl, COL_ACCENT, 0);
     } else {
-        if (last_next_title != "") {
-            lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
-            last_next_title = "";
-        }
+        lv_label_set_text_static(lbl, LV_SYMBOL_LOOP);
+        lv_obj_set_style_text_color(lbl, COL_TEXT2, 0);
     }
+}
 
-    // Repeat
-    if (d->repeatMode != ui_repeat) {
-        lv_obj_t* lbl = lv_obj_get_child(btn_repeat, 0);
-        if (d->repeatMode == "ONE") {
-            lv_label_set_text(lbl, "1");
-            lv_obj_set_style_text_color(lbl, COL_ACCENT, 0);
-        } else if (d->repeatMode == "ALL") {
-            lv_label_set_text(lbl, LV_SYMBOL_LOOP);
-            lv_obj_set_style_text_color(lbl, COL_ACCENT, 0);
-        } else {
-            lv_label_set_text(lbl, LV_SYMBOL_LOOP);
-            lv_obj_set_style_text_color(lbl, COL_TEXT2, 0);
-        }
-        ui_repeat = d->repeatMode;
-    }
-
-    // Album art - only request if URL changed to prevent download loops
-    // NOTE: last_art_url is GLOBAL (extern in ui_common.h), don't shadow it!
-    static String last_track_uri = "";
-    static String last_source_prefix = "";
-
-    // Extract source prefix to detect actual source changes (not just track changes)
-    String current_source_prefix = "";
-    if (d->currentURI.startsWith("x-sonos-vli:")) {
-        current_source_prefix = "x-sonos-vli";  // Spotify, Apple Music, etc
-    } else if (d->currentURI.startsWith("hls-radio://")) {
-        current_source_prefix = "hls-radio";  // Radio
-    } else if (d->currentURI.startsWith("x-sonos-http:")) {
-        current_source_prefix = "x-sonos-http";  // Radio
-    } else if (d->currentURI.startsWith("x-rincon-mp3radio:")) {
-        current_source_prefix = "x-rincon-mp3radio";  // Radio
+// Next track info (resolved from the queue by the controller; empty for radio)
+static void applyNext(const SonosSnapshot* s) {
+    if (s->nextTitle[0]) {
+        lv_label_set_text(lbl_next_title, s->nextTitle);
+        lv_label_set_text(lbl_next_artist, s->nextArtist);
+        lv_obj_clear_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
+        // Thumbnail from the shared cache (same album as current track = instant hit)
+        next_thumb_key = artThumbKey(s->nextArtURL);
+        next_thumb_gen = artThumbGeneration();
+        setNextThumb(artThumbAcquire(next_thumb_key, ART_THUMB_60));
+        if (next_thumb) lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_clear_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
     } else {
-        // Extract first part before colon for unknown sources
-        int colonPos = d->currentURI.indexOf(':');
-        if (colonPos > 0) {
-            current_source_prefix = d->currentURI.substring(0, colonPos);
-        }
+        setNextThumb(nullptr);
+        lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
+        next_thumb_key = 0;
     }
+}
 
-    // Detect ACTUAL source changes (Spotify→Radio, not Spotify track1→track2)
-    bool actual_source_change = (current_source_prefix != last_source_prefix && current_source_prefix.length() > 0);
-
-    // Detect any URI change (track or source)
-    bool uri_changed = (d->currentURI != last_track_uri);
+// New URI: abort the running art download and forget the last art URL
+// NOTE: last_art_url is GLOBAL (extern in ui_common.h), don't shadow it!
+static void applySource(const SonosSnapshot* s) {
+    static char last_source_prefix[32] = "";
+    if (!s->currentURI[0]) return;
+
+    // Source prefix (before the first ':') tells Spotify->Radio from track1->track2
+    char prefix[32] = "";
+    const char* colon = strchr(s->currentURI, ':');
+    if (colon && colon > s->currentURI) {
+        size_t n = colon - s->currentURI;
+        if (n >= sizeof(prefix)) n = sizeof(prefix) - 1;
+        memcpy(prefix, s->currentURI, n);
+        prefix[n] = '\0';
+    }
+    if (prefix[0] && strcmp(prefix, last_source_prefix) != 0) {
+        Serial.printf("[ART] SOURCE CHANGE: %s -> %s\n", last_source_prefix, prefix);
+        strlcpy(last_source_prefix, prefix, sizeof(last_source_prefix));
+    } else {
+        Serial.printf("[ART] Track changed (same source: %s)\n", prefix);
+    }
+    // CRITICAL: Abort any in-progress album art download immediately
+    // Applies to ALL track changes (not just source changes) so the art task
+    // doesn't wait for a 10-second HTTP timeout before processing the new track
+    art_abort_download = true;
+    // CRITICAL: Must hold art_mutex when writing last_art_url - the art task reads
+    // it under mutex, and String assignment is not atomic (race condition → corruption)
+    if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(50))) {
+        last_art_url = "";  // Force art refresh on any URI change
+        xSemaphoreGive(art_mutex);
+    }
+}
 
-    if (uri_changed && d->currentURI.length() > 0) {
-        if (actual_source_change) {
-            Serial.printf("[ART] SOURCE CHANGE: %s -> %s\n", last_source_prefix.c_str(), current_source_prefix.c_str());
-            last_source_prefix = current_source_prefix;
-        } else {
-            Serial.printf("[ART] Track changed (same source: %s)\n", current_source_prefix.c_str());
+// Album art request (runs after applySource for the same change-set)
+static void applyArt(const SonosSnapshot* s) {
+    // For radio: fall back to the station logo when there is no song art
+    bool hasArt = s->albumArtURL[0] || (s->isRadioStation && s->radioStationArtURL[0]);
+    if (!hasArt) return;
+
+    const char* artURL = s->albumArtURL;
+    bool usingStationLogo = false;  // Track if we're using station logo (PNG allowed)
+
+    // RADIO STATION LOGO FALLBACK:
+    // If playing radio and no song art available, use station logo instead
+    if (s->isRadioStation) {
+        bool hasSongArt = artURL[0] != '\0';
+        bool hasStationLogo = s->radioStationArtURL[0] != '\0';
+        Serial.printf("[ART] Radio check - hasSongArt=%d, hasStationLogo=%d, artURL='%s', stationURL='%s'\n",
+                     hasSongArt, hasStationLogo, artURL, s->radioStationArtURL);
+
+        // If no song art but have station logo, use the logo
+        if (!hasSongArt && hasStationLogo) {
+            artURL = s->radioStationArtURL;
+            usingStationLogo = true;
+            Serial.println("[ART] Radio: Using station logo (no song art)");
         }
-        // CRITICAL: Abort any in-progress album art download immediately
-        // Applies to ALL track changes (not just source changes) so the art task
-        // doesn't wait for a 10-second HTTP timeout before processing the new track
-        art_abort_download = true;
-        // CRITICAL: Must hold art_mutex when writing last_art_url - the art task reads
-        // it under mutex, and String assignment is not atomic (race condition → corruption)
-        if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(50))) {
-            last_art_url = "";  // Force art refresh on any URI change
-            xSemaphoreGive(art_mutex);
+        // If song art is just a generic Sonos radio icon, prefer the actual station logo
+        else if (hasSongArt && hasStationLogo && strstr(artURL, "/getaa?") &&
+                 (strstr(artURL, "x-sonosapi-stream") || strstr(artURL, "x-rincon-mp3radio") ||
+                  strstr(artURL, "x-sonosapi-radio"))) {
+            artURL = s->radioStationArtURL;
+            usingStationLogo = true;
+            Serial.println("[ART] Radio: Using station logo (replacing generic icon)");
         }
-        last_track_uri = d->currentURI;
     }
 
-    // Request album art if URL provided and (URL changed or track changed)
-    // Note: Don't compare against last_art_url (HTTP) since d->albumArtURL is HTTPS
-    // Let art task handle deduplication after HTTP conversion
-    // For radio: also check radioStationArtURL if albumArtURL is empty
-    bool hasArt = (d->albumArtURL.length() > 0) || (d->isRadioStation && d->radioStationArtURL.length() > 0);
-    bool artChanged = (d->albumArtURL != pending_art_url) || uri_changed;
+    // Set the flag for album art task to know if PNG is allowed
+    pending_is_station_logo = usingStationLogo;
 
-    // For radio stations: also check if radioStationArtURL changed (even if albumArtURL is empty)
-    if (d->isRadioStation && d->radioStationArtURL.length() > 0 && d->radioStationArtURL != pending_art_url) {
-        artChanged = true;
-    }
+    // Thumbnail key from the URL as the queue reports it (before CDN size rewrites)
+    // CDN size/scheme rewrites happen on the art task (art_url_rules)
+    art_retry = !requestAlbumArt(artURL, artThumbKey(artURL));
+}
 
-    if (hasArt && artChanged) {
-        String artURL = "";
-        bool usingStationLogo = false;  // Track if we're using station logo (PNG allowed)
+// Queue screen: highlight moves on track change, rows rebind on a new queue version
+static void applyQueue(const SonosSnapshot* s) {
+    syncQueueList(s);
+}
 
-        // Determine which art to use
-        if (d->albumArtURL.length() > 0) {
-            artURL = d->albumArtURL;
-        }
+// Radio mode UI adaptation - last, it overrides what the title/art entries set
+static void applyRadioMode(const SonosSnapshot* s) {
+    updateRadioModeUI(s);
+}
 
-        // RADIO STATION LOGO FALLBACK:
-        // If playing radio and no song art available, use station logo instead
-        if (d->isRadioStation) {
-            bool hasSongArt = (artURL.length() > 0);
-            bool hasStationLogo = (d->radioStationArtURL.length() > 0);
-            Serial.printf("[ART] Radio check - hasSongArt=%d, hasStationLogo=%d, artURL='%s', stationURL='%s'\n",
-                         hasSongArt, hasStationLogo, artURL.c_str(), d->radioStationArtURL.c_str());
-
-            // If no song art but have station logo, use the logo
-            if (!hasSongArt && hasStationLogo) {
-                artURL = d->radioStationArtURL;
-                usingStationLogo = true;
-                Serial.println("[ART] Radio: Using station logo (no song art)");
-            }
-            // If song art is just a generic Sonos radio icon, prefer the actual station logo
-            else if (hasSongArt && hasStationLogo && artURL.indexOf("/getaa?") > 0) {
-                // Check if it's pointing to the radio URI (generic icon)
-                if (artURL.indexOf("x-sonosapi-stream") > 0 ||
-                    artURL.indexOf("x-rincon-mp3radio") > 0 ||
-                    artURL.indexOf("x-sonosapi-radio") > 0) {
-                    artURL = d->radioStationArtURL;
-                    usingStationLogo = true;
-                    Serial.println("[ART] Radio: Using station logo (replacing generic icon)");
-                }
-            }
+struct UIDispatch {
+    uint32_t mask;
+    void (*apply)(const SonosSnapshot* s);
+};
+
+// Order matters only where noted: source before art, radio mode last
+static const UIDispatch ui_dispatch[] = {
+    {SNAP_TITLE,                        applyTitle},
+    {SNAP_ALBUM,                        applyAlbum},
+    {SNAP_ROOM,                         applyRoom},
+    {SNAP_POSITION,                     applyPosition},
+    {SNAP_PLAYSTATE,                    applyPlayState},
+    {SNAP_VOLUME,                       applyVolume},
+    {SNAP_MUTE,                         applyMute},
+    {SNAP_SHUFFLE,                      applyShuffle},
+    {SNAP_REPEAT,                       applyRepeat},
+    {SNAP_NEXT,                         applyNext},
+    {SNAP_QUEUE,                        applyQueue},
+    {SNAP_URI,                          applySource},
+    {SNAP_URI | SNAP_ART | SNAP_RADIO,  applyArt},
+    {SNAP_TITLE | SNAP_RADIO,           applyRadioMode},
+};
+
+// Bits whose data only lives in the full snapshot (strings); the rest ride in the change-set
+#define UI_SNAPSHOT_BITS (SNAP_TITLE | SNAP_ALBUM | SNAP_ROOM | SNAP_NEXT | SNAP_URI | SNAP_ART | \
+                          SNAP_RADIO | SNAP_QUEUE | SNAP_CONNECTION)
+
+static void applyChanges(uint32_t mask) {
+    const SonosSnapshot* s = &ui_snap;
+
+    // Handle disconnection - only clear UI once
+    static bool ui_cleared = false;
+    if (!s->connected) {
+        if (!ui_cleared) {
+            clearDisconnected();
+            applyQueue(s);  // Queue list empties and shows "No device"
+            ui_cleared = true;
+            Serial.println("[UI] Device disconnected - UI cleared");
         }
+        return;  // Don't update UI when disconnected
+    }
 
-        // Set the flag for album art task to know if PNG is allowed
-        pending_is_station_logo = usingStationLogo;
+    // Handle reconnection - repaint everything from the snapshot
+    if (ui_cleared) {
+        ui_cleared = false;
+        mask = SNAP_ALL;
+        Serial.println("[UI] Device reconnected - forcing UI refresh");
+    }
+
+    for (size_t i = 0; i < sizeof(ui_dispatch) / sizeof(ui_dispatch[0]); i++) {
+        if (mask & ui_dispatch[i].mask) ui_dispatch[i].apply(s);
+    }
+}
 
-        if (artURL.length() > 0) {
-            // Note: Using ESP32-P4 hardware JPEG decoder - can handle full 640x640 Spotify images!
+// State owned by other tasks (art, lyrics, thumbnail cache) and deferred slider
+// updates - cheap flag checks, run every loop pass
+static void pollDeferred() {
+    const SonosSnapshot* s = &ui_snap;
+    if (!s->connected) return;
 
-            // Apple Music: reduce image size to avoid "too large" errors (1400x1400 can be 500KB+)
-            if (artURL.indexOf("mzstatic.com") > 0) {
-                if (artURL.indexOf("/1400x1400bb.jpg") > 0) {
-                    artURL.replace("/1400x1400bb.jpg", "/400x400bb.jpg");
-                    Serial.println("[ART] Apple Music - reduced to 400x400");
-                } else if (artURL.indexOf("/1080x1080cc.jpg") > 0) {
-                    artURL.replace("/1080x1080cc.jpg", "/400x400cc.jpg");
-                    Serial.println("[ART] Apple Music - reduced to 400x400");
-                }
-            }
+    if (prog_stale && !dragging_prog) applyProgressSlider(s);
+    if (vol_stale && !dragging_vol) applyVolume(s);
+    if (art_retry) applyArt(s);
 
-            requestAlbumArt(artURL);
-            // Don't set last_art_url here - let art task manage it (HTTP vs HTTPS conversion)
-        } else {
-            // No art available - clear display
-            Serial.println("[ART] No art URL - clearing display");
-            if (img_album) lv_obj_add_flag(img_album, LV_OBJ_FLAG_HIDDEN);
-            if (art_placeholder) lv_obj_remove_flag(art_placeholder, LV_OBJ_FLAG_HIDDEN);
-            // CRITICAL: Must hold art_mutex when writing last_art_url (not atomic)
-            if (xSemaphoreTake(art_mutex, pdMS_TO_TICKS(50))) {
-                last_art_url = "";  // Clear to allow next art request
-                xSemaphoreGive(art_mutex);
-            }
-        }
+    if (!next_thumb && next_thumb_key && next_thumb_gen != artThumbGeneration()) {
+        // Cache gained an entry since the last miss - retry once per store
+        next_thumb_gen = artThumbGeneration();
+        setNextThumb(artThumbAcquire(next_thumb_key, ART_THUMB_60));
+        if (next_thumb) lv_obj_add_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
     }
-    if (xSemaphoreTake(art_mutex, 0)) {
+
+    if ((art_ready || color_ready) && xSemaphoreTake(art_mutex, 0)) {
         if (art_ready) {
             lv_img_set_src(img_album, &art_dsc);
             lv_obj_remove_flag(img_album, LV_OBJ_FLAG_HIDDEN);  // Show album art
@@ -1462,14 +1455,96 @@ void updateUI() {
         xSemaphoreGive(art_mutex);
     }
 
-    // Radio mode UI adaptation - must be at the END of updateUI()
-    updateRadioModeUI();
+    // Lyrics task flips these flags - redraw on edges only
+    static bool shown_lyrics_ready = false;
+    static bool shown_lyrics_fetching = false;
+    if (lyrics_fetching != shown_lyrics_fetching) {
+        shown_lyrics_fetching = lyrics_fetching;
+        updateLyricsStatus();
+    }
+    if (lyrics_ready != shown_lyrics_ready) {
+        shown_lyrics_ready = lyrics_ready;
+        updateLyricsDisplay(s->relTimeSeconds);
+    }
 }
 
+// Full repaint from the current snapshot (bench, screen rebuilds)
+void updateUI() {
+    if (!sonos.getCurrentDevice()) return;
+    sonos.readSnapshot(&ui_snap);
+    applyChanges(SNAP_ALL);
+    pollDeferred();
+}
+
+// Allocation counts per update kind (alloc_trace.h): light = payload-only change-sets
+// (position tick, volume, play state), full = a snapshot copy was needed
+struct UpdateStats {
+    uint32_t updates;
+    uint32_t allocs;
+    uint32_t dirty;       // Updates that allocated at all
+    uint32_t max_allocs;
+};
+static UpdateStats update_stats[2];
+static uint32_t last_update_allocs = 0;
+
+// Drain the change-set ring and apply only what changed
 void processUpdates() {
-    static uint32_t lastUpdate = 0;
-    UIUpdate_t upd;
-    bool need = false;
-    while (xQueueReceive(sonos.getUIUpdateQueue(), &upd, 0)) need = true;
-    if (need && (millis() - lastUpdate > 200)) { updateUI(); lastUpdate = millis(); }
+    uint32_t mask = sonos.takeUIOverflow();  // Dropped change-sets carry no payload
+    bool need_snapshot = mask != 0;
+    UIChangeSet cs, last = {};
+    bool have = false;
+    while (sonos.popUIChange(&cs)) {
+        mask |= cs.mask;
+        last = cs;
+        have = true;
+    }
+
+    if (mask) {
+        bool full = need_snapshot || !have || (mask & UI_SNAPSHOT_BITS);
+        allocTraceBegin();
+        if (full) {
+            sonos.readSnapshot(&ui_snap);
+        } else {
+            // Position / volume / play state only - patch from the newest change-set
+            ui_snap.relTimeSeconds = last.relTimeSeconds;
+            ui_snap.durationSeconds = last.durationSeconds;
+            ui_snap.volume = last.volume;
+            ui_snap.repeatMode = last.repeatMode;
+            ui_snap.connected = last.flags & UI_CS_CONNECTED;
+            ui_snap.isPlaying = last.flags & UI_CS_PLAYING;
+            ui_snap.isMuted = last.flags & UI_CS_MUTED;
+            ui_snap.shuffleMode = last.flags & UI_CS_SHUFFLE;
+        }
+        applyChanges(mask);
+        last_update_allocs = allocTraceEnd();
+
+        UpdateStats* st = &update_stats[full ? 1 : 0];
+        st->updates++;
+        st->allocs += last_update_allocs;
+        if (last_update_allocs) st->dirty++;
+        if (last_update_allocs > st->max_allocs) st->max_allocs = last_update_allocs;
+    }
+    pollDeferred();
+    syncBrowseList();
+    syncSearchResults();
+    syncLaunchGrid();
+}
+
+uint32_t uiUpdateLastAllocs() {
+    return last_update_allocs;
+}
+
+void uiUpdateLogStats() {
+    const UpdateStats* l = &update_stats[0];
+    const UpdateStats* f = &update_stats[1];
+    if (!allocTraceEnabled()) {
+        Serial.printf("[UI] Updates: %lu light, %lu full (alloc trace off)\n",
+                      (unsigned long)l->updates, (unsigned long)f->updates);
+    } else {
+        Serial.printf("[UI] Updates: %lu light (%lu allocs, %lu dirty, max %lu), %lu full (%lu allocs, max %lu)\n",
+                      (unsigned long)l->updates, (unsigned long)l->allocs, (unsigned long)l->dirty,
+                      (unsigned long)l->max_allocs, (unsigned long)f->updates, (unsigned long)f->allocs,
+                      (unsigned long)f->max_allocs);
+    }
+    memset(update_stats, 0, sizeof(update_stats));
 }
@@ -0,0 +1,244 @@
+/**
+ * UI Quick-Launch Grid
+ * Sonos Favorites (FV:2) and Playlists (SQ:) as tiles on the Sources screen. The
+ * first page of each is requested in the background and its indexed rows copied out
+ * of the browse cache (rows + arena, offsets unchanged), so a tap is one
+ * playURI / playContainer / playPlaylist call with no browse and no parsing.
+ *
+ * Tile art comes from the thumbnail cache; misses are queued as thumbnail-only art
+ * requests, which also land in the flash art cache - after a reboot the tiles decode
+ * from flash without touching the network.
+ */
+
+#include "ui_common.h"
+#include "art_thumbs.h"
+
+// Copy of one source's first browse page
+struct LaunchSet {
+    const char* objectID;
+    char* arena;                         // PSRAM copy of the page arena
+    BrowseRow rows[BROWSE_PAGE_SIZE];
+    int count;
+    int total;
+    uint32_t updateID;
+    uint32_t arenaSize;                  // With total + updateID: tells a refetched page apart
+
+    const char* str(uint32_t off) const { return arena + off; }
+};
+
+struct LaunchTile {
+    lv_obj_t* btn;
+    lv_obj_t* img;
+    lv_obj_t* icon;
+    lv_obj_t* label;
+    const lv_image_dsc_t* thumb;         // Pinned while the Sources screen is shown
+    int set;                             // -1 = unused
+    int row;
+};
+
+static LaunchSet launch_sets[] = {{"FV:2"}, {"SQ:"}};
+#define LAUNCH_SET_COUNT ((int)(sizeof(launch_sets) / sizeof(launch_sets[0])))
+
+static lv_obj_t* launch_grid = nullptr;
+static lv_obj_t* launch_header = nullptr;
+static LaunchTile launch_tiles[LAUNCH_MAX_TILES];
+static uint32_t launch_version = 0;       // Browse version last captured
+static uint32_t launch_thumb_gen = 0;     // artThumbGeneration() the tiles were bound at
+static uint32_t launch_requested_ms = 0;  // Last background page request
+static bool launch_requested = false;
+
+// ============================================================================
+// Tiles
+// ============================================================================
+static void setTileThumb(LaunchTile* t, const lv_image_dsc_t* dsc) {
+    if (t->thumb) artThumbRelease(t->thumb);
+    t->thumb = dsc;
+    if (dsc) {
+        lv_image_set_src(t->img, dsc);
+        lv_obj_remove_flag(t->img, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(t->icon, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_image_set_src(t->img, NULL);
+        lv_obj_add_flag(t->img, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(t->icon, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+// Pin the tile's thumbnail, or queue its decode (only while the grid is on screen)
+static void bindTileThumb(LaunchTile* t) {
+    if (t->set < 0 || t->thumb) return;
+    const LaunchSet* ls = &launch_sets[t->set];
+    const char* art = ls->str(ls->rows[t->row].art);
+    if (!art[0]) return;
+    const lv_image_dsc_t* dsc = artThumbAcquire(artThumbKey(art), ART_THUMB_120);
+    if (dsc) setTileThumb(t, dsc);
+    else requestArtThumb(art);
+}
+
+static void releaseTileThumbs() {
+    for (int i = 0; i < LAUNCH_MAX_TILES; i++) setTileThumb(&launch_tiles[i], nullptr);
+}
+
+static bool gridShown() {
+    return launch_grid && lv_screen_active() == scr_sources;
+}
+
+// Favorites first, then playlists, up to LAUNCH_MAX_TILES
+static void rebuildLaunchTiles() {
+    int n = 0;
+    for (int s = 0; s < LAUNCH_SET_COUNT; s++) {
+        const LaunchSet* ls = &launch_sets[s];
+        for (int r = 0; r < ls->count && n < LAUNCH_MAX_TILES; r++) {
+            const BrowseRow* row = &ls->rows[r];
+            if (row->action == BROWSE_NONE) continue;
+            LaunchTile* t = &launch_tiles[n++];
+            setTileThumb(t, nullptr);
+            t->set = s;
+            t->row = r;
+            lv_label_set_text(t->label, ls->str(row->title));
+            lv_label_set_text_static(t->icon, s == 0 ? LV_SYMBOL_AUDIO : LV_SYMBOL_LIST);
+            lv_obj_remove_flag(t->btn, LV_OBJ_FLAG_HIDDEN);
+            if (gridShown()) bindTileThumb(t);
+        }
+    }
+    for (int i = n; i < LAUNCH_MAX_TILES; i++) {
+        LaunchTile* t = &launch_tiles[i];
+        setTileThumb(t, nullptr);
+        t->set = -1;
+        lv_obj_add_flag(t->btn, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (n > 0) lv_obj_remove_flag(launch_header, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(launch_header, LV_OBJ_FLAG_HIDDEN);
+    launch_thumb_gen = artThumbGeneration();
+}
+
+static void ev_launch_tile(lv_event_t* e) {
+    LaunchTile* t = &launch_tiles[(int)(intptr_t)lv_event_get_user_data(e)];
+    if (t->set < 0) return;
+    const LaunchSet* ls = &launch_sets[t->set];
+    const BrowseRow* row = &ls->rows[t->row];
+    runBrowseAction(row->action, ls->str(row->id), ls->str(row->title), ls->str(row->uri), ls->str(row->meta));
+}
+
+// Pins are only held while the grid is visible - the thumbnail cache is shared
+static void ev_sources_loaded(lv_event_t* e) {
+    for (int i = 0; i < LAUNCH_MAX_TILES; i++) bindTileThumb(&launch_tiles[i]);
+    launch_thumb_gen = artThumbGeneration();
+}
+
+static void ev_sources_unloaded(lv_event_t* e) {
+    releaseTileThumbs();
+}
+
+// ============================================================================
+// Background population
+// ============================================================================
+// Copy a source's first page if it is cached and differs from the copy held
+static bool captureLaunchSet(LaunchSet* ls) {
+    if (!sonos.lockBrowse()) return false;
+    const BrowsePage* pg = sonos.getBrowsePage(ls->objectID, 0);
+    bool fresh = pg && pg->arena &&
+                 (!ls->arena || pg->updateID != ls->updateID || pg->total != ls->total || pg->arenaSize != ls->arenaSize);
+    char* arena = fresh ? (char*)heap_caps_malloc(pg->arenaSize, MALLOC_CAP_SPIRAM) : nullptr;
+    if (arena) {
+        memcpy(arena, pg->arena, pg->arenaSize);
+        memcpy(ls->rows, pg->rows, sizeof(BrowseRow) * pg->count);
+        if (ls->arena) heap_caps_free(ls->arena);
+        ls->arena = arena;
+        ls->arenaSize = pg->arenaSize;
+        ls->count = pg->count;
+        ls->total = pg->total;
+        ls->updateID = pg->updateID;
+    }
+    sonos.unlockBrowse();
+    if (arena) Serial.printf("[LAUNCH] %s: %d items (%lu bytes)\n", ls->objectID, ls->count, (unsigned long)ls->arenaSize);
+    return arena != nullptr;
+}
+
+// Called every UI pass - request the pages now and then, copy them when they land
+void syncLaunchGrid() {
+    if (!launch_grid || !sonos.getCurrentDevice()) return;
+
+    // Re-requesting a cached page past BROWSE_REVALIDATE_MS re-checks its UpdateID
+    uint32_t now = millis();
+    uint32_t interval = launch_sets[0].arena ? LAUNCH_REFRESH_MS : 5000;  // Retry sooner until captured
+    if (!launch_requested || now - launch_requested_ms > interval) {
+        for (int s = 0; s < LAUNCH_SET_COUNT; s++) sonos.requestBrowse(launch_sets[s].objectID, 0, false);
+        launch_requested = true;
+        launch_requested_ms = now;
+    }
+
+    uint32_t version = sonos.getBrowseVersion();
+    if (version != launch_version) {
+        launch_version = version;
+        bool changed = false;
+        for (int s = 0; s < LAUNCH_SET_COUNT; s++) changed |= captureLaunchSet(&launch_sets[s]);
+        if (changed) rebuildLaunchTiles();
+    }
+
+    // New thumbnails decoded - fill the tiles still showing an icon
+    if (gridShown() && artThumbGeneration() != launch_thumb_gen) {
+        launch_thumb_gen = artThumbGeneration();
+        for (int i = 0; i < LAUNCH_MAX_TILES; i++) bindTileThumb(&launch_tiles[i]);
+    }
+}
+
+// ============================================================================
+// Grid
+// ============================================================================
+void createLaunchGrid(lv_obj_t* parent) {
+    launch_header = lv_label_create(parent);
+    lv_label_set_text(launch_header, "Quick Launch");
+    lv_obj_set_style_text_color(launch_header, COL_TEXT2, 0);
+    lv_obj_set_style_text_font(launch_header, &lv_font_montserrat_14, 0);
+    lv_obj_add_flag(launch_header, LV_OBJ_FLAG_HIDDEN);
+
+    launch_grid = lv_obj_create(parent);
+    lv_obj_remove_style_all(launch_grid);
+    lv_obj_set_size(launch_grid, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(launch_grid, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_row(launch_grid, 10, 0);
+    lv_obj_set_style_pad_column(launch_grid, 10, 0);
+    lv_obj_remove_flag(launch_grid, LV_OBJ_FLAG_SCROLLABLE);
+
+    for (int i = 0; i < LAUNCH_MAX_TILES; i++) {
+        LaunchTile* t = &launch_tiles[i];
+        t->btn = lv_btn_create(launch_grid);
+        lv_obj_set_size(t->btn, LAUNCH_TILE_WIDTH, LAUNCH_TILE_HEIGHT);
+        lv_obj_set_style_radius(t->btn, 12, 0);
+        lv_obj_set_style_shadow_width(t->btn, 0, 0);
+        lv_obj_set_style_bg_color(t->btn, COL_CARD, 0);
+        lv_obj_set_style_bg_color(t->btn, COL_BTN_PRESSED, LV_STATE_PRESSED);
+        lv_obj_set_style_pad_all(t->btn, 8, 0);
+        lv_obj_add_flag(t->btn, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(t->btn, ev_launch_tile, LV_EVENT_CLICKED, (void*)(intptr_t)i);
+
+        t->img = lv_image_create(t->btn);
+        lv_obj_set_size(t->img, ART_THUMB_SIZE_L, ART_THUMB_SIZE_L);
+        lv_obj_set_style_radius(t->img, 8, 0);
+        lv_obj_set_style_clip_corner(t->img, true, 0);
+        lv_obj_align(t->img, LV_ALIGN_TOP_MID, 0, 0);
+        lv_obj_add_flag(t->img, LV_OBJ_FLAG_HIDDEN);
+
+        // Placeholder until the thumbnail is decoded (or for items without art)
+        t->icon = lv_label_create(t->btn);
+        lv_obj_set_style_text_color(t->icon, COL_ACCENT, 0);
+        lv_obj_set_style_text_font(t->icon, &lv_font_montserrat_32, 0);
+        lv_obj_align(t->icon, LV_ALIGN_TOP_MID, 0, ART_THUMB_SIZE_L / 2 - 16);
+
+        t->label = lv_label_create(t->btn);
+        lv_obj_set_width(t->label, lv_pct(100));
+        lv_obj_set_style_text_color(t->label, COL_TEXT, 0);
+        lv_obj_set_style_text_font(t->label, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_align(t->label, LV_TEXT_ALIGN_CENTER, 0);
+        lv_label_set_long_mode(t->label, LV_LABEL_LONG_DOT);
+        lv_obj_align(t->label, LV_ALIGN_BOTTOM_MID, 0, 0);
+
+        t->thumb = nullptr;
+        t->set = -1;
+    }
+
+    lv_obj_t* screen = lv_obj_get_screen(parent);
+    lv_obj_add_event_cb(screen, ev_sources_loaded, LV_EVENT_SCREEN_LOADED, NULL);
+    lv_obj_add_event_cb(screen, ev_sources_unloaded, LV_EVENT_SCREEN_UNLOADED, NULL);
+}
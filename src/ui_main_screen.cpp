@@ -324,13 +324,15 @@ void createMainScreen() {
     // ===== PLAY NEXT SECTION (below volume) =====
     int next_y = 440;
 
-    // Small album art for next track (hidden for now)
+    // Small album art for next track - replaces the "Next:" header when the
+    // next track's art is in the thumbnail cache (60px level stretched to 36px)
     img_next_album = lv_img_create(panel_right);
-    lv_obj_set_pos(img_next_album, 20, next_y);
-    lv_obj_set_size(img_next_album, 40, 40);
+    lv_obj_set_pos(img_next_album, 20, next_y + 2);
+    lv_obj_set_size(img_next_album, 36, 36);
+    lv_image_set_inner_align(img_next_album, LV_IMAGE_ALIGN_STRETCH);
     lv_obj_set_style_radius(img_next_album, 4, 0);
     lv_obj_set_style_clip_corner(img_next_album, true, 0);
-    lv_obj_add_flag(img_next_album, LV_OBJ_FLAG_HIDDEN); // Hide thumbnail for now
+    lv_obj_add_flag(img_next_album, LV_OBJ_FLAG_HIDDEN); // Shown by updateUI() on thumbnail hit
 
     // "Next:" label
     lbl_next_header = lv_label_create(panel_right);  // Use GLOBAL, not local!
@@ -0,0 +1,480 @@
+/**
+ * UI Queue Screen
+ * Virtual list: QUEUE_ROW_POOL row widgets are created once and rebound to queue
+ * indices as the list scrolls; a transparent spacer gives the scroll range.
+ * All rows share static styles - the "now playing" row is LV_STATE_CHECKED.
+ * Items come from the controller's page cache; rows of pages that aren't loaded
+ * show a placeholder until the page arrives.
+ *
+ * Edit mode selects a range of rows (tap, then tap another to extend) for remove,
+ * move up/down and play next. Edits show at once - the controller applies them to
+ * its pages and sends them in the background.
+ */
+
+#include "ui_common.h"
+#include "art_thumbs.h"
+
+struct QueueRow {
+    lv_obj_t* row;
+    lv_obj_t* num;
+    lv_obj_t* thumb;
+    lv_obj_t* title;
+    lv_obj_t* artist;
+    const lv_image_dsc_t* thumb_dsc;  // Pinned thumbnail (released on rebind)
+    int index;                        // Bound queue index, -1 = unbound
+    char num_text[8];
+};
+
+static QueueRow queue_rows[QUEUE_ROW_POOL];
+static lv_obj_t* queue_spacer = nullptr;
+static int queue_count = 0;
+static int queue_playing = 0;            // Track number (1-based) shown as playing
+static uint32_t queue_bound_version = 0;
+
+// Queue fields of the last snapshot applied (syncQueueList) - the list never reads SonosDevice
+static bool queue_connected = false;
+static int queue_snap_size = 0;
+static int queue_snap_track = 0;
+
+static lv_obj_t* queue_edit_bar = nullptr;
+static lv_obj_t* btn_queue_edit = nullptr;
+static bool queue_editing = false;
+static int sel_first = -1;               // Selected range, -1 = none
+static int sel_last = -1;
+
+static void ev_queue_row(lv_event_t* e);
+
+static lv_style_t st_row, st_row_pressed, st_row_playing, st_row_selected;
+static lv_style_t st_num, st_num_playing, st_title, st_title_playing, st_artist, st_thumb;
+
+static void initQueueStyles() {
+    lv_style_init(&st_row);
+    lv_style_set_bg_color(&st_row, lv_color_hex(0x1A1A1A));
+    lv_style_set_bg_opa(&st_row, LV_OPA_COVER);
+    lv_style_set_pad_all(&st_row, 12);
+
+    lv_style_init(&st_row_pressed);
+    lv_style_set_bg_color(&st_row_pressed, lv_color_hex(0x2A2A2A));
+
+    // Subtle left border for currently playing
+    lv_style_init(&st_row_playing);
+    lv_style_set_bg_color(&st_row_playing, lv_color_hex(0x252525));
+    lv_style_set_border_side(&st_row_playing, LV_BORDER_SIDE_LEFT);
+    lv_style_set_border_width(&st_row_playing, 3);
+    lv_style_set_border_color(&st_row_playing, COL_ACCENT);
+
+    // Edit mode selection
+    lv_style_init(&st_row_selected);
+    lv_style_set_bg_color(&st_row_selected, lv_color_hex(0x3A3320));
+
+    lv_style_init(&st_num);
+    lv_style_set_text_font(&st_num, &lv_font_montserrat_14);
+    lv_style_set_text_color(&st_num, COL_TEXT2);
+
+    lv_style_init(&st_num_playing);
+    lv_style_set_text_font(&st_num_playing, &lv_font_montserrat_18);
+    lv_style_set_text_color(&st_num_playing, COL_ACCENT);
+
+    lv_style_init(&st_title);
+    lv_style_set_text_font(&st_title, &lv_font_montserrat_16);
+    lv_style_set_text_color(&st_title, COL_TEXT);
+
+    lv_style_init(&st_title_playing);
+    lv_style_set_text_color(&st_title_playing, COL_ACCENT);
+
+    // Artist - subtle gray
+    lv_style_init(&st_artist);
+    lv_style_set_text_font(&st_artist, &lv_font_montserrat_12);
+    lv_style_set_text_color(&st_artist, COL_TEXT2);
+
+    lv_style_init(&st_thumb);
+    lv_style_set_radius(&st_thumb, 4);
+    lv_style_set_clip_corner(&st_thumb, true);
+}
+
+static void createQueueRow(QueueRow* r) {
+    r->row = lv_obj_create(list_queue);
+    lv_obj_remove_style_all(r->row);
+    lv_obj_add_style(r->row, &st_row, 0);
+    lv_obj_add_style(r->row, &st_row_pressed, LV_STATE_PRESSED);
+    lv_obj_add_style(r->row, &st_row_playing, LV_STATE_CHECKED);
+    lv_obj_add_style(r->row, &st_row_selected, LV_STATE_USER_1);
+    lv_obj_set_size(r->row, 727, QUEUE_ROW_HEIGHT);  // Full width, uniform height
+    lv_obj_remove_flag(r->row, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(r->row, ev_queue_row, LV_EVENT_CLICKED, NULL);
+
+    // Play icon for currently playing track OR track number
+    r->num = lv_label_create(r->row);
+    lv_obj_add_style(r->num, &st_num, 0);
+    lv_obj_add_style(r->num, &st_num_playing, LV_STATE_CHECKED);
+    lv_obj_align(r->num, LV_ALIGN_LEFT_MID, 5, 0);
+
+    // Album art thumbnail if already decoded (never triggers a download)
+    r->thumb = lv_image_create(r->row);
+    lv_obj_add_style(r->thumb, &st_thumb, 0);
+    lv_obj_set_size(r->thumb, 36, 36);
+    lv_image_set_inner_align(r->thumb, LV_IMAGE_ALIGN_STRETCH);
+    lv_obj_align(r->thumb, LV_ALIGN_LEFT_MID, 40, 0);
+    lv_obj_add_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+
+    // Title - highlight when playing
+    r->title = lv_label_create(r->row);
+    lv_obj_add_style(r->title, &st_title, 0);
+    lv_obj_add_style(r->title, &st_title_playing, LV_STATE_CHECKED);
+    lv_label_set_long_mode(r->title, LV_LABEL_LONG_DOT);
+
+    r->artist = lv_label_create(r->row);
+    lv_obj_add_style(r->artist, &st_artist, 0);
+    lv_label_set_long_mode(r->artist, LV_LABEL_LONG_DOT);
+
+    r->thumb_dsc = nullptr;
+    r->index = -1;
+}
+
+static void setRowThumb(QueueRow* r, const lv_image_dsc_t* dsc) {
+    if (r->thumb_dsc) artThumbRelease(r->thumb_dsc);  // Acquired first - same slot stays pinned
+    r->thumb_dsc = dsc;
+    int text_x = dsc ? 88 : 45;
+    if (dsc) {
+        lv_image_set_src(r->thumb, dsc);
+        lv_obj_remove_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_image_set_src(r->thumb, NULL);
+        lv_obj_add_flag(r->thumb, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_obj_set_width(r->title, 655 - text_x);
+    lv_obj_align(r->title, LV_ALIGN_LEFT_MID, text_x, -11);
+    lv_obj_set_width(r->artist, 655 - text_x);
+    lv_obj_align(r->artist, LV_ALIGN_LEFT_MID, text_x, 11);
+}
+
+static void setRowPlaying(QueueRow* r, bool playing) {
+    if (playing) {
+        lv_obj_add_state(r->row, LV_STATE_CHECKED);
+        lv_obj_add_state(r->num, LV_STATE_CHECKED);
+        lv_obj_add_state(r->title, LV_STATE_CHECKED);
+        lv_label_set_text_static(r->num, LV_SYMBOL_PLAY);
+    } else {
+        lv_obj_remove_state(r->row, LV_STATE_CHECKED);
+        lv_obj_remove_state(r->num, LV_STATE_CHECKED);
+        lv_obj_remove_state(r->title, LV_STATE_CHECKED);
+        lv_label_set_text_static(r->num, r->num_text);
+    }
+}
+
+static void setRowSelected(QueueRow* r) {
+    if (r->index >= sel_first && r->index <= sel_last) lv_obj_add_state(r->row, LV_STATE_USER_1);
+    else lv_obj_remove_state(r->row, LV_STATE_USER_1);
+}
+
+static void bindQueueRow(QueueRow* r, int index) {
+    if (index >= queue_count) {
+        if (r->index >= 0) {
+            setRowThumb(r, nullptr);
+            lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+            r->index = -1;
+        }
+        return;
+    }
+    static QueueItemView item;  // LVGL thread only
+    int trackNum = index + 1;
+    r->index = index;
+    lv_obj_set_y(r->row, index * QUEUE_ROW_HEIGHT);
+    lv_obj_set_user_data(r->row, (void*)(intptr_t)trackNum);
+    snprintf(r->num_text, sizeof(r->num_text), "%d", trackNum);
+    if (sonos.getQueueItem(index, &item)) {
+        lv_label_set_text(r->title, item.title);
+        lv_label_set_text(r->artist, item.artist);
+        setRowThumb(r, artThumbAcquire(artThumbKey(item.albumArtURL), ART_THUMB_60));
+    } else {
+        // Page not loaded yet - rebound when it arrives (queue version bump)
+        lv_label_set_text_static(r->title, "Loading...");
+        lv_label_set_text_static(r->artist, "");
+        setRowThumb(r, nullptr);
+    }
+    setRowPlaying(r, trackNum == queue_playing);
+    setRowSelected(r);
+    lv_obj_remove_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Bind the pool to the rows around the scroll position. Index i always lives in
+// slot i % QUEUE_ROW_POOL, so scrolling by one row rebinds exactly one widget.
+static void layoutQueueRows(bool rebind_all) {
+    int first = lv_obj_get_scroll_y(list_queue) / QUEUE_ROW_HEIGHT - QUEUE_ROW_OVERSCAN;
+    if (first < 0) first = 0;
+    sonos.setQueueView(first, first + QUEUE_ROW_POOL - 1);  // Fetches pages that aren't resident
+    for (int i = first; i < first + QUEUE_ROW_POOL; i++) {
+        QueueRow* r = &queue_rows[i % QUEUE_ROW_POOL];
+        if (rebind_all || r->index != i) bindQueueRow(r, i);
+    }
+}
+
+static void ev_queue_scroll(lv_event_t* e) {
+    layoutQueueRows(false);
+}
+
+// ============================================================================
+// Editing
+// ============================================================================
+static void updateQueueStatus() {
+    if (!queue_connected) lv_label_set_text(lbl_queue_status, "No device");
+    else if (queue_editing && sel_first >= 0) lv_label_set_text_fmt(lbl_queue_status, "%d selected", sel_last - sel_first + 1);
+    else if (queue_editing) lv_label_set_text(lbl_queue_status, "Tap tracks to select");
+    else if (queue_count == 0) lv_label_set_text(lbl_queue_status, "Queue is empty");
+    else lv_label_set_text_fmt(lbl_queue_status, "%d %s in queue", queue_count, queue_count == 1 ? "track" : "tracks");
+}
+
+static void setSelection(int first, int last) {
+    sel_first = first;
+    sel_last = last;
+    for (int i = 0; i < QUEUE_ROW_POOL; i++) {
+        if (queue_rows[i].index >= 0) setRowSelected(&queue_rows[i]);
+    }
+    if (sel_first >= 0) lv_obj_remove_flag(queue_edit_bar, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(queue_edit_bar, LV_OBJ_FLAG_HIDDEN);
+    updateQueueStatus();
+}
+
+static void setQueueEditing(bool editing) {
+    queue_editing = editing;
+    lv_obj_set_style_bg_color(btn_queue_edit, editing ? COL_ACCENT : lv_color_hex(0x333333), 0);
+    setSelection(-1, -1);
+}
+
+// Rows play their track, or in edit mode build the selection
+static void ev_queue_row(lv_event_t* e) {
+    if (!queue_editing) {
+        ev_queue_item(e);
+        return;
+    }
+    int index = (int)(intptr_t)lv_obj_get_user_data((lv_obj_t*)lv_event_get_target(e)) - 1;
+    if (sel_first < 0) setSelection(index, index);
+    else if (index < sel_first || index > sel_last) setSelection(min(sel_first, index), max(sel_last, index));
+    else if (sel_first == sel_last) setSelection(-1, -1);
+    else setSelection(index, index);
+}
+
+enum QueueEditAction { QEDIT_NEXT, QEDIT_UP, QEDIT_DOWN, QEDIT_REMOVE };
+
+static void ev_queue_edit_action(lv_event_t* e) {
+    if (sel_first < 0) return;
+    int n = sel_last - sel_first + 1;
+    int to = -1;
+    switch ((int)(intptr_t)lv_event_get_user_data(e)) {
+        case QEDIT_NEXT: {
+            int cur = queue_playing - 1;
+            if (cur < 0 || (cur >= sel_first && cur <= sel_last)) return;
+            to = sel_first > cur ? cur + 1 : cur + 1 - n;
+            break;
+        }
+        case QEDIT_UP:
+            to = sel_first - 1;
+            break;
+        case QEDIT_DOWN:
+            to = sel_last + 1 < queue_count ? sel_first + 1 : -1;
+            break;
+        case QEDIT_REMOVE:
+            if (sonos.removeQueueTracks(sel_first, n)) setSelection(-1, -1);
+            return;
+    }
+    if (to < 0 || to == sel_first) return;
+    if (sonos.moveQueueTracks(sel_first, n, to)) setSelection(to, to + n - 1);
+}
+
+static void ev_queue_edit(lv_event_t* e) {
+    setQueueEditing(!queue_editing);
+}
+
+// Off screen the list no longer pins pages around its scroll position
+static void ev_queue_unloaded(lv_event_t* e) {
+    sonos.setQueueView(-1, -1);
+    if (queue_editing) setQueueEditing(false);
+}
+
+// ============================================================================
+// Queue Screen
+// ============================================================================
+void refreshQueueList() {
+    queue_count = queue_snap_size;
+    queue_playing = queue_snap_track;
+    queue_bound_version = sonos.getQueueVersion();
+    int first, last;
+    sonos.takeQueueDirtyRange(&first, &last);  // Everything is rebound below
+    if (sel_last >= queue_count) setSelection(-1, -1);  // Queue shrank under the selection
+    updateQueueStatus();
+
+    lv_obj_set_height(queue_spacer, queue_count * QUEUE_ROW_HEIGHT);
+    lv_obj_update_layout(list_queue);
+    lv_obj_readjust_scroll(list_queue, LV_ANIM_OFF);  // Queue may have shrunk below the scroll position
+    layoutQueueRows(true);
+}
+
+// Track changes only move the highlight; a new queue version rebinds the rows whose
+// items changed (all of them if the length changed)
+void syncQueueList(const SonosSnapshot* s) {
+    queue_connected = s->connected;
+    queue_snap_size = s->connected ? s->queueSize : 0;
+    queue_snap_track = s->connected ? s->currentTrackNumber : 0;
+    if (!list_queue) return;
+    int currentTrack = queue_snap_track;
+    int queueSize = queue_snap_size;
+    uint32_t queueVersion = s->queueVersion;
+    if (queueVersion != queue_bound_version || queueSize != queue_count) {
+        if (lv_screen_active() != scr_queue) return;  // ev_queue refreshes on open
+        if (queueSize != queue_count) {
+            refreshQueueList();
+            return;
+        }
+        queue_bound_version = queueVersion;
+        int first, last;
+        if (sonos.takeQueueDirtyRange(&first, &last)) {
+            for (int i = 0; i < QUEUE_ROW_POOL; i++) {
+                QueueRow* r = &queue_rows[i];
+                if (r->index >= first && r->index <= last) bindQueueRow(r, r->index);
+            }
+            layoutQueueRows(false);  // An edit may have cut a page short - refetch it
+        }
+    }
+    if (currentTrack == queue_playing) return;
+    int old_playing = queue_playing;
+    queue_playing = currentTrack;
+    for (int i = 0; i < QUEUE_ROW_POOL; i++) {
+        QueueRow* r = &queue_rows[i];
+        if (r->index < 0) continue;
+        if (r->index + 1 == old_playing || r->index + 1 == currentTrack) setRowPlaying(r, r->index + 1 == currentTrack);
+    }
+}
+
+void createQueueScreen() {
+    scr_queue = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr_queue, lv_color_hex(0x1A1A1A), 0);
+
+    // Professional header
+    lv_obj_t* header = lv_obj_create(scr_queue);
+    lv_obj_set_size(header, 800, 70);
+    lv_obj_set_pos(header, 0, 0);
+    lv_obj_set_style_bg_color(header, lv_color_hex(0x252525), 0);
+    lv_obj_set_style_border_width(header, 0, 0);
+    lv_obj_set_style_radius(header, 0, 0);
+    lv_obj_set_style_pad_all(header, 0, 0);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+
+    // Title in header
+    lv_obj_t* lbl_title = lv_label_create(header);
+    lv_label_set_text(lbl_title, "Playlist");
+    lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_32, 0);
+    lv_obj_set_style_text_color(lbl_title, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_align(lbl_title, LV_ALIGN_LEFT_MID, 30, 0);
+
+    // Refresh button in header
+    lv_obj_t* btn_refresh = lv_button_create(header);
+    lv_obj_set_size(btn_refresh, 50, 50);
+    lv_obj_align(btn_refresh, LV_ALIGN_RIGHT_MID, -80, 0);
+    lv_obj_set_style_bg_color(btn_refresh, lv_color_hex(0x333333), 0);
+    lv_obj_set_style_radius(btn_refresh, 25, 0);
+    lv_obj_set_style_shadow_width(btn_refresh, 0, 0);
+    lv_obj_add_event_cb(btn_refresh, [](lv_event_t* e) { sonos.requestQueueRefresh(); }, LV_EVENT_CLICKED, NULL);
+    lv_obj_t* ico_refresh = lv_label_create(btn_refresh);
+    lv_label_set_text(ico_refresh, LV_SYMBOL_REFRESH);
+    lv_obj_set_style_text_color(ico_refresh, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_text_font(ico_refresh, &lv_font_montserrat_24, 0);
+    lv_obj_center(ico_refresh);
+
+    // Edit toggle in header
+    btn_queue_edit = lv_button_create(header);
+    lv_obj_set_size(btn_queue_edit, 50, 50);
+    lv_obj_align(btn_queue_edit, LV_ALIGN_RIGHT_MID, -140, 0);
+    lv_obj_set_style_bg_color(btn_queue_edit, lv_color_hex(0x333333), 0);
+    lv_obj_set_style_radius(btn_queue_edit, 25, 0);
+    lv_obj_set_style_shadow_width(btn_queue_edit, 0, 0);
+    lv_obj_add_event_cb(btn_queue_edit, ev_queue_edit, LV_EVENT_CLICKED, NULL);
+    lv_obj_t* ico_edit = lv_label_create(btn_queue_edit);
+    lv_label_set_text(ico_edit, LV_SYMBOL_EDIT);
+    lv_obj_set_style_text_color(ico_edit, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_text_font(ico_edit, &lv_font_montserrat_24, 0);
+    lv_obj_center(ico_edit);
+
+    // Close button in header
+    lv_obj_t* btn_close = lv_button_create(header);
+    lv_obj_set_size(btn_close, 50, 50);
+    lv_obj_align(btn_close, LV_ALIGN_RIGHT_MID, -20, 0);
+    lv_obj_set_style_bg_color(btn_close, lv_color_hex(0x333333), 0);
+    lv_obj_set_style_radius(btn_close, 25, 0);
+    lv_obj_set_style_shadow_width(btn_close, 0, 0);
+    lv_obj_add_event_cb(btn_close, ev_back_main, LV_EVENT_CLICKED, NULL);
+    lv_obj_t* ico_close = lv_label_create(btn_close);
+    lv_label_set_text(ico_close, LV_SYMBOL_CLOSE);
+    lv_obj_set_style_text_color(ico_close, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_text_font(ico_close, &lv_font_montserrat_24, 0);
+    lv_obj_center(ico_close);
+
+    // Status label below header
+    lbl_queue_status = lv_label_create(scr_queue);
+    lv_obj_align(lbl_queue_status, LV_ALIGN_TOP_LEFT, 40, 85);
+    lv_label_set_text(lbl_queue_status, "Loading...");
+    lv_obj_set_style_text_color(lbl_queue_status, COL_TEXT2, 0);
+    lv_obj_set_style_text_font(lbl_queue_status, &lv_font_montserrat_14, 0);
+
+    // Edit actions for the selection (edit mode, right of the status label)
+    queue_edit_bar = lv_obj_create(scr_queue);
+    lv_obj_remove_style_all(queue_edit_bar);
+    lv_obj_set_size(queue_edit_bar, LV_SIZE_CONTENT, 36);
+    lv_obj_align(queue_edit_bar, LV_ALIGN_TOP_RIGHT, -35, 76);
+    lv_obj_set_flex_flow(queue_edit_bar, LV_FLEX_FLOW_ROW);
+    lv_obj_set_style_pad_column(queue_edit_bar, 8, 0);
+    lv_obj_add_flag(queue_edit_bar, LV_OBJ_FLAG_HIDDEN);
+    static const struct { const char* text; int action; } edit_actions[] = {
+        {LV_SYMBOL_NEXT " Play Next", QEDIT_NEXT},
+        {LV_SYMBOL_UP, QEDIT_UP},
+        {LV_SYMBOL_DOWN, QEDIT_DOWN},
+        {LV_SYMBOL_TRASH " Remove", QEDIT_REMOVE},
+    };
+    for (const auto& a : edit_actions) {
+        lv_obj_t* btn = lv_button_create(queue_edit_bar);
+        lv_obj_set_height(btn, 36);
+        lv_obj_set_style_pad_hor(btn, 14, 0);
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x333333), 0);
+        lv_obj_set_style_bg_color(btn, COL_BTN_PRESSED, LV_STATE_PRESSED);
+        lv_obj_set_style_radius(btn, 18, 0);
+        lv_obj_set_style_shadow_width(btn, 0, 0);
+        lv_obj_add_event_cb(btn, ev_queue_edit_action, LV_EVENT_CLICKED, (void*)(intptr_t)a.action);
+        lv_obj_t* lbl = lv_label_create(btn);
+        lv_label_set_text(lbl, a.text);
+        lv_obj_set_style_text_color(lbl, COL_TEXT, 0);
+        lv_obj_set_style_text_font(lbl, &lv_font_montserrat_14, 0);
+        lv_obj_center(lbl);
+    }
+
+    // Queue list - modern clean design (rows positioned absolutely, no flex)
+    list_queue = lv_obj_create(scr_queue);
+    lv_obj_set_size(list_queue, 730, 360);
+    lv_obj_set_pos(list_queue, 35, 115);
+    lv_obj_set_style_bg_color(list_queue, lv_color_hex(0x1A1A1A), 0);
+    lv_obj_set_style_border_width(list_queue, 0, 0);
+    lv_obj_set_style_radius(list_queue, 0, 0);
+    lv_obj_set_style_pad_all(list_queue, 0, 0);
+    lv_obj_set_scroll_dir(list_queue, LV_DIR_VER);
+
+    // Modern thin scrollbar on the right edge
+    lv_obj_set_style_pad_right(list_queue, 3, LV_PART_SCROLLBAR);
+    lv_obj_set_style_bg_opa(list_queue, LV_OPA_COVER, LV_PART_SCROLLBAR);
+    lv_obj_set_style_bg_color(list_queue, COL_ACCENT, LV_PART_SCROLLBAR);
+    lv_obj_set_style_width(list_queue, 3, LV_PART_SCROLLBAR);
+    lv_obj_set_style_radius(list_queue, 0, LV_PART_SCROLLBAR);
+
+    // Spacer sets the scroll range; the row pool floats over it
+    queue_spacer = lv_obj_create(list_queue);
+    lv_obj_remove_style_all(queue_spacer);
+    lv_obj_set_size(queue_spacer, 1, 0);
+    lv_obj_remove_flag(queue_spacer, LV_OBJ_FLAG_CLICKABLE);
+
+    static bool styles_ready = false;
+    if (!styles_ready) {
+        initQueueStyles();
+        styles_ready = true;
+    }
+    for (int i = 0; i < QUEUE_ROW_POOL; i++) createQueueRow(&queue_rows[i]);
+    lv_obj_add_event_cb(list_queue, ev_queue_scroll, LV_EVENT_SCROLL, NULL);
+    lv_obj_add_event_cb(scr_queue, ev_queue_unloaded, LV_EVENT_SCREEN_UNLOADED, NULL);
+}
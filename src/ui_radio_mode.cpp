@@ -56,91 +56,67 @@ void setRadioMode(bool enable) {
         if (lbl_time) lv_obj_clear_flag(lbl_time, LV_OBJ_FLAG_HIDDEN);
         if (lbl_time_remaining) lv_obj_clear_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);
 
-        // Show next track info
-        if (img_next_album) lv_obj_clear_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
+        // Show next track info (thumbnail replaces the header when one is attached)
+        bool has_thumb = img_next_album && lv_image_get_src(img_next_album) != nullptr;
+        if (img_next_album && has_thumb) lv_obj_clear_flag(img_next_album, LV_OBJ_FLAG_HIDDEN);
         if (lbl_next_title) lv_obj_clear_flag(lbl_next_title, LV_OBJ_FLAG_HIDDEN);
         if (lbl_next_artist) lv_obj_clear_flag(lbl_next_artist, LV_OBJ_FLAG_HIDDEN);
-        if (lbl_next_header) lv_obj_clear_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
+        if (lbl_next_header && !has_thumb) lv_obj_clear_flag(lbl_next_header, LV_OBJ_FLAG_HIDDEN);
     }
 }
 
-// Update UI based on current track type
-// Call this at the END of updateUI() to ensure radio mode takes effect
-void updateRadioModeUI() {
-    SonosDevice* dev = sonos.getCurrentDevice();
-    if (!dev) return;
+// True if needle occurs somewhere after the first character
+static bool containsAfterStart(const char* text, const char* needle) {
+    const char* p = strstr(text, needle);
+    return p && p > text;
+}
+
+// Song text that is really a stream URL fragment
+static bool isUrlJunk(const char* text) {
+    return containsAfterStart(text, "?") ||
+           containsAfterStart(text, ".mp3") ||
+           containsAfterStart(text, ".m3u8") ||
+           containsAfterStart(text, "accessKey=") ||
+           strstr(text, "index-cmaf") ||
+           strstr(text, "index-ts");
+}
 
-    bool isRadio = dev->isRadioStation;
+// Update UI based on current track type
+// Dispatched last for a change-set (after title and art) so radio mode takes effect
+void updateRadioModeUI(const SonosSnapshot* s) {
+    bool isRadio = s->isRadioStation;
     setRadioMode(isRadio);
 
     if (!isRadio) return;
 
     // For radio: Use radioStationName for title if available
-    // The currentTrack field may contain current song from streamContent
+    // The title field may contain current song from streamContent
     // or it may contain URL junk - we need to be smart about this
 
-    String displayTitle = "";
-    String displayArtist = "";
-
     // Priority 1: Use radioStationName from GetMediaInfo (the actual station name)
-    if (dev->radioStationName.length() > 0) {
-        displayTitle = dev->radioStationName;
-    }
-
-    // Priority 2: If currentTrack looks valid (not URL junk), use it
-    // This could be the current song from streamContent parsing
-    if (dev->currentTrack.length() > 0) {
-        String track = dev->currentTrack;
-        bool isJunk = (track.indexOf("?") > 0 ||
-                      track.indexOf(".mp3") > 0 ||
-                      track.indexOf(".m3u8") > 0 ||
-                      track.indexOf("accessKey=") > 0 ||
-                      track.indexOf("index-cmaf") >= 0 ||
-                      track.indexOf("index-ts") >= 0);
-
-        if (!isJunk) {
-            // If we have a station name, use currentTrack as the "now playing" info
-            if (displayTitle.length() > 0) {
-                // Station name is set, currentTrack might be the song
-                // We could show both but for now, prioritize station name
-                // The currentArtist will show the song info
-            } else {
-                // No station name from GetMediaInfo, use currentTrack
-                displayTitle = track;
-            }
-        }
+    // Priority 2: If the title looks valid (not URL junk), use it
+    // (with a station name, the artist line carries the song info instead)
+    const char* displayTitle = s->radioStationName;
+    if (!displayTitle[0] && s->title[0] && !isUrlJunk(s->title)) {
+        displayTitle = s->title;
     }
 
     // Fallback: Generic label if nothing else works
-    if (displayTitle.length() == 0) {
+    if (!displayTitle[0]) {
         displayTitle = "Radio Station";
     }
 
-    // Artist: Use currentArtist if available, otherwise "Live Radio"
-    if (dev->currentArtist.length() > 0) {
-        displayArtist = dev->currentArtist;
-    } else {
-        displayArtist = "Live Radio";
-    }
+    // Artist: Use the artist if available, otherwise "Live Radio"
+    const char* displayArtist = s->artist[0] ? s->artist : "Live Radio";
 
-    // Update UI labels
-    static String last_displayed_title = "";
-    static String last_displayed_artist = "";
-
-    // Only log when actually changing
-    if (displayTitle != last_displayed_title || displayArtist != last_displayed_artist) {
-        Serial.printf("[RADIO UI] Updating display - Title: '%s', Artist: '%s'\n",
-                     displayTitle.c_str(), displayArtist.c_str());
-        Serial.printf("[RADIO UI] Source data - StationName: '%s', CurrentTrack: '%s', CurrentArtist: '%s'\n",
-                     dev->radioStationName.c_str(), dev->currentTrack.c_str(), dev->currentArtist.c_str());
-        last_displayed_title = displayTitle;
-        last_displayed_artist = displayArtist;
-    }
+    Serial.printf("[RADIO UI] Updating display - Title: '%s', Artist: '%s'\n", displayTitle, displayArtist);
+    Serial.printf("[RADIO UI] Source data - StationName: '%s', CurrentTrack: '%s', CurrentArtist: '%s'\n",
+                 s->radioStationName, s->title, s->artist);
 
     if (lbl_title) {
-        lv_label_set_text(lbl_title, displayTitle.c_str());
+        lv_label_set_text(lbl_title, displayTitle);
     }
     if (lbl_artist) {
-        lv_label_set_text(lbl_artist, displayArtist.c_str());
+        lv_label_set_text(lbl_artist, displayArtist);
     }
 }
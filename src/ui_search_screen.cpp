@@ -0,0 +1,366 @@
+/**
+ * UI Search Screen
+ * Type-ahead search of the Sonos music library. Sonos answers searches as browses
+ * of A:ARTIST:<term>, A:ALBUM:<term> and A:TRACKS:<term>, so queries go through the
+ * browse cache (sonos_browse.cpp) like any folder: a newer query supersedes the one
+ * still pending, and tapping a result opens or plays it like a browse row.
+ *
+ * Typing refines locally first. The last SEARCH_RECENT result sets are kept; if one
+ * was complete for a prefix of the new term, filtering it is the answer and no query
+ * goes out. Otherwise the closest one is shown filtered while the debounced query runs.
+ */
+
+#include "ui_common.h"
+
+enum SearchCategory : uint8_t {
+    SEARCH_ARTISTS = 0,
+    SEARCH_ALBUMS,
+    SEARCH_TRACKS,
+    SEARCH_CATEGORY_COUNT
+};
+
+static const char* const SEARCH_ROOTS[SEARCH_CATEGORY_COUNT] = {"A:ARTIST", "A:ALBUM", "A:TRACKS"};
+static const char* const SEARCH_TABS[] = {"Artists", "Albums", "Tracks", ""};
+
+// First page of one query, titles copied for local filtering
+struct SearchRecent {
+    char term[SEARCH_TERM_LEN];          // Lower-case, "" = free
+    uint8_t category;
+    char objectID[BROWSE_ID_LEN];        // Browse cache folder the rows belong to
+    int total;                           // TotalMatches
+    int count;                           // Titles kept
+    uint32_t lastUse;
+    char title[BROWSE_PAGE_SIZE][SEARCH_TITLE_LEN];
+    bool container[BROWSE_PAGE_SIZE];
+};
+
+struct SearchRow {
+    lv_obj_t* btn;
+    lv_obj_t* icon;
+    lv_obj_t* label;
+};
+
+static lv_obj_t* search_ta = nullptr;
+static lv_obj_t* search_tabs = nullptr;
+static lv_obj_t* search_list = nullptr;
+static lv_obj_t* search_status = nullptr;
+static lv_obj_t* search_kb = nullptr;
+static lv_timer_t* search_timer = nullptr;    // Debounce, paused while idle
+static SearchRow search_rows[SEARCH_RESULT_ROWS];
+static SearchRecent* search_recent = nullptr; // SEARCH_RECENT entries
+static uint8_t search_category = SEARCH_ARTISTS;
+static char search_term[SEARCH_TERM_LEN];     // Current term, lower-case
+static int shown_set = -1;                    // Recent entry the rows come from
+static int16_t shown_index[SEARCH_RESULT_ROWS];  // Row -> index in that entry
+
+// Query waiting for its page ("" = none)
+static char pending_id[BROWSE_ID_LEN];
+static char pending_term[SEARCH_TERM_LEN];
+static uint8_t pending_category = SEARCH_ARTISTS;
+static uint32_t pending_ticket = 0;
+static uint32_t search_version = 0;
+
+// ============================================================================
+// Terms and matching
+// ============================================================================
+// Lower-case ASCII, surrounding spaces trimmed
+static void normalizeTerm(const char* in, char* out) {
+    while (*in == ' ') in++;
+    size_t n = 0;
+    for (; in[n] && n < SEARCH_TERM_LEN - 1; n++) out[n] = (char)tolower((unsigned char)in[n]);
+    while (n > 0 && out[n - 1] == ' ') n--;
+    out[n] = '\0';
+}
+
+// "A:ARTIST:<term>" with the term percent-encoded (':' and '/' separate ID levels)
+static void searchObjectID(uint8_t category, const char* term, char* out, size_t size) {
+    int n = snprintf(out, size, "%s:", SEARCH_ROOTS[category]);
+    for (const char* p = term; *p && n < (int)size - 4; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (isalnum(c)) out[n++] = c;
+        else n += snprintf(out + n, size - n, "%%%02X", c);
+    }
+    out[n] = '\0';
+}
+
+// A word of the title starts with the term - how the library matches
+static bool titleMatches(const char* title, const char* term) {
+    size_t len = strlen(term);
+    for (const char* p = title; *p; p++) {
+        bool word_start = p == title || p[-1] == ' ' || p[-1] == '(' || p[-1] == '-';
+        if (word_start && strncasecmp(p, term, len) == 0) return true;
+    }
+    return false;
+}
+
+// Exact set for the current term, or the longest prefix set (complete ones only if asked)
+static int findRecent(bool exact, bool complete_only) {
+    int best = -1;
+    size_t best_len = 0;
+    for (int i = 0; i < SEARCH_RECENT; i++) {
+        SearchRecent* r = &search_recent[i];
+        if (!r->term[0] || r->category != search_category) continue;
+        size_t len = strlen(r->term);
+        if (exact) {
+            if (strcmp(r->term, search_term) == 0) return i;
+            continue;
+        }
+        if (strncmp(search_term, r->term, len) != 0) continue;
+        if (complete_only && r->total > r->count) continue;
+        if (len > best_len) {
+            best = i;
+            best_len = len;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+static void setSearchStatus(const char* text) {
+    lv_label_set_text(search_status, text);
+}
+
+// Rows from a recent set - filtered by the current term unless it is that set's term
+static void showResults(int set) {
+    SearchRecent* r = set >= 0 ? &search_recent[set] : nullptr;
+    bool filter = r && strcmp(r->term, search_term) != 0;
+    int shown = 0;
+    int matches = 0;
+    if (r) {
+        r->lastUse = millis();
+        for (int i = 0; i < r->count; i++) {
+            if (filter && !titleMatches(r->title[i], search_term)) continue;
+            matches++;
+            if (shown >= SEARCH_RESULT_ROWS) continue;
+            SearchRow* row = &search_rows[shown];
+            lv_label_set_text_static(row->icon, r->container[i] ? LV_SYMBOL_DIRECTORY : LV_SYMBOL_AUDIO);
+            lv_label_set_text(row->label, r->title[i]);
+            lv_obj_remove_flag(row->btn, LV_OBJ_FLAG_HIDDEN);
+            shown_index[shown++] = i;
+        }
+    }
+    for (int i = shown; i < SEARCH_RESULT_ROWS; i++) lv_obj_add_flag(search_rows[i].btn, LV_OBJ_FLAG_HIDDEN);
+    shown_set = set;
+    lv_obj_scroll_to_y(search_list, 0, LV_ANIM_OFF);
+
+    if (pending_id[0]) setSearchStatus("Searching...");
+    else if (!r) setSearchStatus("");
+    else if (matches == 0) setSearchStatus("No matches");
+    else if (!filter && r->total > r->count)
+        lv_label_set_text_fmt(search_status, "First %d of %d - keep typing to narrow", r->count, r->total);
+    else lv_label_set_text_fmt(search_status, "%d %s", matches, matches == 1 ? "result" : "results");
+}
+
+// Least recently used set (or a free one)
+static SearchRecent* allocRecent() {
+    SearchRecent* victim = &search_recent[0];
+    for (int i = 0; i < SEARCH_RECENT; i++) {
+        SearchRecent* r = &search_recent[i];
+        if (!r->term[0]) return r;
+        if (r->lastUse < victim->lastUse) victim = r;
+    }
+    return victim;
+}
+
+// Copy the pending query's page out of the browse cache; false = not there yet
+static bool takePendingPage() {
+    if (!sonos.lockBrowse()) return false;
+    const BrowsePage* pg = sonos.getBrowsePage(pending_id, 0);
+    if (!pg) {
+        sonos.unlockBrowse();
+        return false;
+    }
+    SearchRecent* r = allocRecent();
+    strlcpy(r->term, pending_term, sizeof(r->term));
+    r->category = pending_category;
+    strlcpy(r->objectID, pending_id, sizeof(r->objectID));
+    r->total = pg->total;
+    r->count = pg->count;
+    r->lastUse = millis();
+    for (int i = 0; i < pg->count; i++) {
+        strlcpy(r->title[i], pg->str(pg->rows[i].title), SEARCH_TITLE_LEN);
+        r->container[i] = pg->rows[i].container;
+    }
+    sonos.unlockBrowse();
+
+    Serial.printf("[SEARCH] %s: %d of %d\n", pending_id, r->count, r->total);
+    pending_id[0] = '\0';
+    if (r->category == search_category && strcmp(r->term, search_term) == 0) showResults(r - search_recent);
+    return true;
+}
+
+static void ev_search_debounce(lv_timer_t* t) {
+    lv_timer_pause(t);
+    searchObjectID(search_category, search_term, pending_id, sizeof(pending_id));
+    strlcpy(pending_term, search_term, sizeof(pending_term));
+    pending_category = search_category;
+    pending_ticket = sonos.requestBrowse(pending_id, 0, true);  // Supersedes the previous query
+    if (!takePendingPage()) search_version = 0;  // Check on the next UI pass
+}
+
+// Every keystroke / tab change: answer locally if possible, else debounce a query
+static void onSearchChanged() {
+    normalizeTerm(lv_textarea_get_text(search_ta), search_term);
+    pending_id[0] = '\0';  // A landing page for an older term is only cached
+    lv_timer_pause(search_timer);
+
+    if (strlen(search_term) < SEARCH_MIN_CHARS) {
+        showResults(-1);
+        setSearchStatus(search_term[0] ? "Keep typing..." : "");
+        return;
+    }
+    int set = findRecent(true, false);
+    if (set < 0) set = findRecent(false, true);  // Complete for a prefix - filtering is exact
+    if (set >= 0) {
+        showResults(set);
+        return;
+    }
+    showResults(findRecent(false, false));  // Preview while the query runs
+    setSearchStatus("Searching...");
+    lv_timer_reset(search_timer);
+    lv_timer_resume(search_timer);
+}
+
+// Called every UI pass - cheap unless a query is pending and a page landed
+void syncSearchResults() {
+    if (!search_list || !pending_id[0] || lv_screen_active() != scr_search) return;
+    uint32_t version = sonos.getBrowseVersion();
+    if (version == search_version) return;
+    if (takePendingPage()) return;
+    if (sonos.browseFailed(pending_ticket)) {
+        pending_id[0] = '\0';
+        setSearchStatus("Search failed");
+    }
+    search_version = version;
+}
+
+static void ev_search_result(lv_event_t* e) {
+    int row = (int)(intptr_t)lv_event_get_user_data(e);
+    if (shown_set < 0) return;
+    lv_obj_add_flag(search_kb, LV_OBJ_FLAG_HIDDEN);
+    activateBrowseItem(search_recent[shown_set].objectID, shown_index[row]);
+}
+
+// ============================================================================
+// Search Screen
+// ============================================================================
+void createSearchScreen() {
+    if (scr_search) return;
+    search_recent = (SearchRecent*)heap_caps_calloc(SEARCH_RECENT, sizeof(SearchRecent), MALLOC_CAP_SPIRAM);
+    if (!search_recent) search_recent = (SearchRecent*)calloc(SEARCH_RECENT, sizeof(SearchRecent));
+    if (!search_recent) {
+        Serial.println("[SEARCH] ERROR: No memory for recent results");
+        return;
+    }
+
+    scr_search = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr_search, lv_color_hex(0x121212), 0);
+
+    // Create sidebar and get content area (Sources is index 3)
+    lv_obj_t* content = createSettingsSidebar(scr_search, 3);
+    lv_obj_clear_flag(content, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* lbl_title = lv_label_create(content);
+    lv_label_set_text(lbl_title, "Search");
+    lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_color(lbl_title, COL_TEXT, 0);
+    lv_obj_set_pos(lbl_title, 0, 0);
+
+    search_ta = lv_textarea_create(content);
+    lv_obj_set_size(search_ta, 300, 40);
+    lv_obj_set_pos(search_ta, 0, 40);
+    lv_textarea_set_one_line(search_ta, true);
+    lv_textarea_set_max_length(search_ta, SEARCH_TERM_LEN - 1);
+    lv_textarea_set_placeholder_text(search_ta, "Artist, album or track");
+    lv_obj_set_style_bg_color(search_ta, COL_CARD, 0);
+    lv_obj_set_style_text_color(search_ta, COL_TEXT, 0);
+    lv_obj_set_style_border_color(search_ta, COL_BTN, 0);
+    lv_obj_add_event_cb(search_ta, [](lv_event_t* e) {
+        lv_event_code_t code = lv_event_get_code(e);
+        if (code == LV_EVENT_FOCUSED) lv_obj_clear_flag(search_kb, LV_OBJ_FLAG_HIDDEN);
+        else if (code == LV_EVENT_VALUE_CHANGED) onSearchChanged();
+    }, LV_EVENT_ALL, NULL);
+
+    search_tabs = lv_buttonmatrix_create(content);
+    lv_buttonmatrix_set_map(search_tabs, SEARCH_TABS);
+    lv_buttonmatrix_set_button_ctrl_all(search_tabs, LV_BUTTONMATRIX_CTRL_CHECKABLE);
+    lv_buttonmatrix_set_one_checked(search_tabs, true);
+    lv_buttonmatrix_set_button_ctrl(search_tabs, SEARCH_ARTISTS, LV_BUTTONMATRIX_CTRL_CHECKED);
+    lv_obj_set_size(search_tabs, 270, 40);
+    lv_obj_set_pos(search_tabs, 310, 40);
+    lv_obj_set_style_bg_opa(search_tabs, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(search_tabs, 0, 0);
+    lv_obj_set_style_pad_all(search_tabs, 0, 0);
+    lv_obj_set_style_bg_color(search_tabs, COL_CARD, LV_PART_ITEMS);
+    lv_obj_set_style_bg_color(search_tabs, COL_ACCENT, LV_PART_ITEMS | LV_STATE_CHECKED);
+    lv_obj_set_style_text_color(search_tabs, COL_TEXT, LV_PART_ITEMS);
+    lv_obj_set_style_text_font(search_tabs, &lv_font_montserrat_14, LV_PART_ITEMS);
+    lv_obj_add_event_cb(search_tabs, [](lv_event_t* e) {
+        uint32_t tab = lv_buttonmatrix_get_selected_button(search_tabs);
+        if (tab >= SEARCH_CATEGORY_COUNT || tab == search_category) return;
+        search_category = (uint8_t)tab;
+        onSearchChanged();
+    }, LV_EVENT_VALUE_CHANGED, NULL);
+
+    search_status = lv_label_create(content);
+    lv_obj_set_style_text_color(search_status, COL_TEXT2, 0);
+    lv_obj_set_style_text_font(search_status, &lv_font_montserrat_14, 0);
+    lv_obj_set_pos(search_status, 0, 90);
+    lv_label_set_text(search_status, "");
+
+    // Result rows are created once and rebound per query
+    search_list = lv_obj_create(content);
+    lv_obj_set_pos(search_list, 0, 115);
+    lv_obj_set_size(search_list, lv_pct(100), 340);
+    lv_obj_set_style_bg_color(search_list, COL_BG, 0);
+    lv_obj_set_style_border_width(search_list, 0, 0);
+    lv_obj_set_style_pad_all(search_list, 0, 0);
+    lv_obj_set_flex_flow(search_list, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(search_list, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+    lv_obj_set_style_pad_row(search_list, 8, 0);
+    for (int i = 0; i < SEARCH_RESULT_ROWS; i++) {
+        SearchRow* row = &search_rows[i];
+        row->btn = lv_btn_create(search_list);
+        lv_obj_set_size(row->btn, lv_pct(100), 50);
+        lv_obj_set_style_radius(row->btn, 12, 0);
+        lv_obj_set_style_shadow_width(row->btn, 0, 0);
+        lv_obj_set_style_bg_color(row->btn, COL_CARD, 0);
+        lv_obj_set_style_bg_color(row->btn, COL_BTN_PRESSED, LV_STATE_PRESSED);
+        lv_obj_set_style_pad_all(row->btn, 15, 0);
+        lv_obj_add_flag(row->btn, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(row->btn, ev_search_result, LV_EVENT_CLICKED, (void*)(intptr_t)i);
+
+        row->icon = lv_label_create(row->btn);
+        lv_obj_set_style_text_color(row->icon, COL_ACCENT, 0);
+        lv_obj_set_style_text_font(row->icon, &lv_font_montserrat_20, 0);
+        lv_obj_align(row->icon, LV_ALIGN_LEFT_MID, 5, 0);
+
+        row->label = lv_label_create(row->btn);
+        lv_obj_set_style_text_color(row->label, COL_TEXT, 0);
+        lv_obj_set_style_text_font(row->label, &lv_font_montserrat_16, 0);
+        lv_obj_align(row->label, LV_ALIGN_LEFT_MID, 40, 0);
+        lv_label_set_long_mode(row->label, LV_LABEL_LONG_DOT);
+        lv_obj_set_width(row->label, lv_pct(90));
+    }
+
+    search_kb = lv_keyboard_create(scr_search);
+    lv_keyboard_set_textarea(search_kb, search_ta);
+    lv_keyboard_set_mode(search_kb, LV_KEYBOARD_MODE_TEXT_LOWER);
+    lv_obj_set_size(search_kb, 615, 175);
+    lv_obj_align(search_kb, LV_ALIGN_BOTTOM_MID, 90, -5);  // Clear of the sidebar
+    lv_obj_set_style_bg_color(search_kb, COL_CARD, 0);
+    lv_obj_set_style_pad_all(search_kb, 5, 0);
+    lv_obj_set_style_radius(search_kb, 10, 0);
+    lv_obj_set_style_bg_color(search_kb, COL_BTN, LV_PART_ITEMS);
+    lv_obj_set_style_text_color(search_kb, COL_TEXT, LV_PART_ITEMS);
+    lv_obj_set_style_radius(search_kb, 6, LV_PART_ITEMS);  // Shown on open - the screen is for typing
+    lv_obj_add_event_cb(search_kb, [](lv_event_t* e) {
+        lv_event_code_t code = lv_event_get_code(e);
+        if (code == LV_EVENT_READY || code == LV_EVENT_CANCEL) lv_obj_add_flag(search_kb, LV_OBJ_FLAG_HIDDEN);
+    }, LV_EVENT_ALL, NULL);
+
+    search_timer = lv_timer_create(ev_search_debounce, SEARCH_DEBOUNCE_MS, NULL);
+    lv_timer_pause(search_timer);
+}
@@ -0,0 +1,124 @@
+/**
+ * Art URL rewrite rule tests (host)
+ * One case per rule in art_url_rules.cpp, plus hosts that must not match and
+ * output-buffer overflow.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "art_url_rules.h"
+
+static char out[512];
+
+static void check(const char* in, const char* expect, uint8_t expect_flags) {
+    uint8_t flags = 0xFF;
+    size_t len = artRewriteURL(in, out, sizeof(out), &flags);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expect, out, in);
+    TEST_ASSERT_EQUAL_UINT(strlen(expect), len);
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(expect_flags, flags, in);
+}
+
+// ============================================================================
+// Sonos Radio imgix wrapper
+// ============================================================================
+void test_imgix_unwrap() {
+    // The inner URL goes through the rules again (Spotify CDN -> HTTP)
+    check("https://sonosradio.imgix.net/bg/default.jpg?w=640&mark=https://i.scdn.co/image/ab67616d0000b273&fit=crop",
+          "http://i.scdn.co/image/ab67616d0000b273", ART_URL_UNWRAPPED | ART_URL_DOWNGRADED);
+}
+
+void test_imgix_without_mark_unchanged() {
+    check("https://sonosradio.imgix.net/bg/default.jpg?w=640", "https://sonosradio.imgix.net/bg/default.jpg?w=640", 0);
+}
+
+// ============================================================================
+// Size negotiation (smallest variant >= ART_DISPLAY_SIZE, never upscaled)
+// ============================================================================
+void test_deezer_resized_to_420() {
+    check("https://e-cdns-images.dzcdn.net/images/cover/1a2b3c/1000x1000-000000-80-0-0.jpg",
+          "http://e-cdns-images.dzcdn.net/images/cover/1a2b3c/420x420-000000-80-0-0.jpg",
+          ART_URL_RESIZED | ART_URL_DOWNGRADED);
+}
+
+void test_deezer_small_not_upscaled() {
+    check("https://e-cdns-images.dzcdn.net/images/cover/1a2b3c/250x250-000000-80-0-0.jpg",
+          "http://e-cdns-images.dzcdn.net/images/cover/1a2b3c/250x250-000000-80-0-0.jpg", ART_URL_DOWNGRADED);
+}
+
+void test_apple_resized_to_420() {
+    // mzstatic stays on HTTPS
+    check("https://is1-ssl.mzstatic.com/image/thumb/Music126/v4/aa/bb/cc/source/600x600bb.jpg",
+          "https://is1-ssl.mzstatic.com/image/thumb/Music126/v4/aa/bb/cc/source/420x420bb.jpg", ART_URL_RESIZED);
+}
+
+void test_tunein_d_resized_to_420() {
+    check("https://cdn-profiles.tunein.com/s24940/images/logod.png?d=600",
+          "http://cdn-profiles.tunein.com/s24940/images/logod.png?d=420", ART_URL_RESIZED | ART_URL_DOWNGRADED);
+    check("https://cdn-profiles.tunein.com/s24940/images/logod.png?t=1&d=300",
+          "http://cdn-profiles.tunein.com/s24940/images/logod.png?t=1&d=300", ART_URL_DOWNGRADED);
+}
+
+// ============================================================================
+// HTTPS -> HTTP downgrade
+// ============================================================================
+void test_https_downgrade_public_cdns() {
+    check("https://i.scdn.co/image/ab67616d0000b273", "http://i.scdn.co/image/ab67616d0000b273", ART_URL_DOWNGRADED);
+    check("https://mosaic.scdn.co/640/abc", "http://mosaic.scdn.co/640/abc", ART_URL_DOWNGRADED);
+    check("https://cdn-radiotime-logos.tunein.com/s1234q.png", "http://cdn-radiotime-logos.tunein.com/s1234q.png",
+          ART_URL_DOWNGRADED);
+    // Host match is case-insensitive; the port is not part of the host
+    check("https://I.SCDN.CO:443/image/x", "http://I.SCDN.CO:443/image/x", ART_URL_DOWNGRADED);
+}
+
+void test_unknown_hosts_unchanged() {
+    check("https://example.com/art/600x600.jpg", "https://example.com/art/600x600.jpg", 0);
+    check("https://notscdn.co/image/x", "https://notscdn.co/image/x", 0);        // Not a label boundary
+    check("https://i.scdn.co.evil.com/image/x", "https://i.scdn.co.evil.com/image/x", 0);
+    check("https://other.tunein.com/logo.png?d=600", "https://other.tunein.com/logo.png?d=600", 0);
+}
+
+// ============================================================================
+// Sonos getaa
+// ============================================================================
+void test_getaa_u_escaping() {
+    check("http://192.168.1.20:1400/getaa?s=1&u=x-sonos-http%3atrack%3a123.mp4?sid=204&flags=8224",
+          "http://192.168.1.20:1400/getaa?s=1&u=x-sonos-http%3atrack%3a123.mp4%3Fsid=204&flags=8224", ART_URL_ESCAPED);
+    // Only u= is escaped, and only on /getaa
+    check("http://192.168.1.20:1400/img?u=a?b", "http://192.168.1.20:1400/img?u=a?b", 0);
+}
+
+// ============================================================================
+// Buffer handling
+// ============================================================================
+void test_overflow_returns_empty() {
+    char small[16];
+    uint8_t flags = 0;
+    TEST_ASSERT_EQUAL_UINT(0, artRewriteURL("https://i.scdn.co/image/ab67616d0000b273", small, sizeof(small), &flags));
+    TEST_ASSERT_EQUAL_STRING("", small);
+}
+
+void test_exact_fit() {
+    const char* in = "http://a.b/c";
+    char buf[13];  // strlen + terminator
+    TEST_ASSERT_EQUAL_UINT(12, artRewriteURL(in, buf, sizeof(buf), nullptr));
+    TEST_ASSERT_EQUAL_STRING(in, buf);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_imgix_unwrap);
+    RUN_TEST(test_imgix_without_mark_unchanged);
+    RUN_TEST(test_deezer_resized_to_420);
+    RUN_TEST(test_deezer_small_not_upscaled);
+    RUN_TEST(test_apple_resized_to_420);
+    RUN_TEST(test_tunein_d_resized_to_420);
+    RUN_TEST(test_https_downgrade_public_cdns);
+    RUN_TEST(test_unknown_hosts_unchanged);
+    RUN_TEST(test_getaa_u_escaping);
+    RUN_TEST(test_overflow_returns_empty);
+    RUN_TEST(test_exact_fit);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+/**
+ * Rotation kernel tests (host)
+ * The tiled kernel must match the original 256x32 block kernel bit for bit, for any
+ * rect, stride and destination alignment the flush callback can pass. Also reports
+ * host timings for both kernels (relative only - the P4 numbers come from [DISPLAY]).
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "display_rotate.h"
+
+// Kernel before the tiling change, kept as the reference
+static void rotate_image_90_ref(const uint16_t *src, int src_stride, int width, int height,
+                                uint16_t *dst, int dst_stride) {
+    constexpr int block_w = 256;
+    constexpr int block_h = 32;
+
+    for (int i = 0; i < height; i += block_h) {
+        int max_height = (i + block_h > height) ? height : (i + block_h);
+
+        for (int j = 0; j < width; j += block_w) {
+            int max_width = (j + block_w > width) ? width : (j + block_w);
+
+            for (int x = i; x < max_height; x++) {
+                for (int y = j; y < max_width; y++) {
+                    const uint16_t *src_pixel = src + (x * src_stride + y);
+                    uint16_t *dst_pixel = dst + (y * dst_stride + (height - 1 - x));
+                    *dst_pixel = *src_pixel;
+                }
+            }
+        }
+    }
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t rng() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void fill_random(std::vector<uint16_t>& v) {
+    for (auto& p : v) p = (uint16_t)rng();
+}
+
+// Rotate with both kernels into sentinel-filled buffers and compare everything,
+// so writes outside the destination rect are caught too
+static void check_rect(int w, int h, int src_stride, int dst_stride, int dst_offset) {
+    std::vector<uint16_t> src((size_t)src_stride * h);
+    fill_random(src);
+    size_t dst_len = (size_t)dst_stride * w + dst_offset + 1;
+    std::vector<uint16_t> expect(dst_len, 0xA5A5);
+    std::vector<uint16_t> got(dst_len, 0xA5A5);
+
+    rotate_image_90_ref(src.data(), src_stride, w, h, expect.data() + dst_offset, dst_stride);
+    rotate_image_90(src.data(), src_stride, w, h, got.data() + dst_offset, dst_stride);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "w=%d h=%d src_stride=%d dst_stride=%d offset=%d", w, h, src_stride, dst_stride, dst_offset);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY_MESSAGE(expect.data(), got.data(), dst_len, msg);
+}
+
+void test_full_frame() {
+    check_rect(800, 480, 800, 480, 0);
+}
+
+void test_edge_sizes() {
+    // Single pixels, lines and tile-boundary sizes
+    const int sizes[] = {1, 2, 3, 31, 32, 33, 63, 64, 65};
+    for (int w : sizes) {
+        for (int h : sizes) {
+            check_rect(w, h, w, h, 0);
+            check_rect(w, h, w + 3, h + 1, 1);
+        }
+    }
+}
+
+void test_random_rects() {
+    for (int i = 0; i < 500; i++) {
+        int w = 1 + rng() % 200;
+        int h = 1 + rng() % 120;
+        int src_stride = w + rng() % 17;  // LVGL pads rows to the stride alignment
+        int dst_stride = h + rng() % 9;   // Frame buffer rows are wider than the rect
+        check_rect(w, h, src_stride, dst_stride, rng() % 2);
+    }
+}
+
+// Portrait frame buffer placement: dirty areas land at any (px, py) in a 480-px-wide buffer
+void test_random_areas_in_frame() {
+    for (int i = 0; i < 100; i++) {
+        int w = 1 + rng() % 800;
+        int h = 1 + rng() % 480;
+        int px = rng() % (480 - h + 1);
+        check_rect(w, h, w + rng() % 17, 480, px);
+    }
+}
+
+template <typename F>
+static double time_us(F fn, int iterations) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+}
+
+static void bench(const char* name, int w, int h, int dst_stride) {
+    std::vector<uint16_t> src((size_t)w * h);
+    std::vector<uint16_t> dst((size_t)dst_stride * w);
+    fill_random(src);
+    const int iterations = 200;
+    double ref = time_us([&] { rotate_image_90_ref(src.data(), w, w, h, dst.data(), dst_stride); }, iterations);
+    double tiled = time_us([&] { rotate_image_90(src.data(), w, w, h, dst.data(), dst_stride); }, iterations);
+    printf("[BENCH] %-12s %3dx%-3d  256x32: %8.1f us  tiled: %8.1f us  (%.2fx)\n",
+           name, w, h, ref, tiled, ref / tiled);
+}
+
+void test_benchmark() {
+    bench("full frame", 800, 480, 480);
+    bench("album art", 420, 420, 480);
+    bench("progress", 800, 24, 480);
+    bench("label", 300, 40, 480);
+    TEST_PASS();
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_frame);
+    RUN_TEST(test_edge_sizes);
+    RUN_TEST(test_random_rects);
+    RUN_TEST(test_random_areas_in_frame);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}